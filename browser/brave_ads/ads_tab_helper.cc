@@ -74,14 +74,12 @@ void AdsTabHelper::TabUpdated() {
                              is_browser_active_);
 }
 
-void AdsTabHelper::RunIsolatedJavaScript(
-    content::RenderFrameHost* render_frame_host) {
+void AdsTabHelper::ProcessPage(content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
+  // The ads library requests the page head through |AdsService| only if the
+  // redirect chain matches a conversion
+  ads_service_->OnPageLoaded(tab_id_, redirect_chain_);
 
   dom_distiller::RunIsolatedJavaScript(
       render_frame_host, "document.body.innerText",
@@ -89,16 +87,6 @@ void AdsTabHelper::RunIsolatedJavaScript(
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
-  DCHECK(ads_service_ && ads_service_->IsEnabled());
-
-  DCHECK(value.is_string());
-  std::string html;
-  value.GetAsString(&html);
-
-  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, html);
-}
-
 void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
   DCHECK(ads_service_ && ads_service_->IsEnabled());
 
@@ -136,7 +124,7 @@ void AdsTabHelper::DidFinishNavigation(
   content::RenderFrameHost* render_frame_host =
       navigation_handle->GetRenderFrameHost();
 
-  RunIsolatedJavaScript(render_frame_host);
+  ProcessPage(render_frame_host);
 }
 
 void AdsTabHelper::DocumentOnLoadCompletedInMainFrame() {
@@ -151,7 +139,7 @@ void AdsTabHelper::DocumentOnLoadCompletedInMainFrame() {
   content::RenderFrameHost* render_frame_host =
       handle->web_contents()->GetMainFrame();
 
-  RunIsolatedJavaScript(render_frame_host);
+  ProcessPage(render_frame_host);
 }
 
 void AdsTabHelper::DidFinishLoad(content::RenderFrameHost* render_frame_host,
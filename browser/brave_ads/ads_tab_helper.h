@@ -59,9 +59,7 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void TabUpdated();
 
-  void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
-
-  void OnJavaScriptHtmlResult(base::Value value);
+  void ProcessPage(content::RenderFrameHost* render_frame_host);
 
   void OnJavaScriptTextResult(base::Value value);
 
@@ -0,0 +1,52 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/brave_shields/shields_settings_snapshot_cache_factory.h"
+
+#include "brave/components/brave_shields/browser/shields_settings_snapshot_cache.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/incognito_helpers.h"
+#include "components/keyed_service/content/browser_context_dependency_manager.h"
+
+namespace brave_shields {
+
+// static
+ShieldsSettingsSnapshotCache*
+ShieldsSettingsSnapshotCacheFactory::GetForBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<ShieldsSettingsSnapshotCache*>(
+      GetInstance()->GetServiceForBrowserContext(context,
+                                                 /*create_service=*/true));
+}
+
+// static
+ShieldsSettingsSnapshotCacheFactory*
+ShieldsSettingsSnapshotCacheFactory::GetInstance() {
+  return base::Singleton<ShieldsSettingsSnapshotCacheFactory>::get();
+}
+
+ShieldsSettingsSnapshotCacheFactory::ShieldsSettingsSnapshotCacheFactory()
+    : BrowserContextKeyedServiceFactory(
+          "ShieldsSettingsSnapshotCache",
+          BrowserContextDependencyManager::GetInstance()) {
+  DependsOn(HostContentSettingsMapFactory::GetInstance());
+}
+
+ShieldsSettingsSnapshotCacheFactory::~ShieldsSettingsSnapshotCacheFactory() {}
+
+KeyedService* ShieldsSettingsSnapshotCacheFactory::BuildServiceInstanceFor(
+    content::BrowserContext* context) const {
+  return new ShieldsSettingsSnapshotCache(
+      HostContentSettingsMapFactory::GetForProfile(context));
+}
+
+content::BrowserContext*
+ShieldsSettingsSnapshotCacheFactory::GetBrowserContextToUse(
+    content::BrowserContext* context) const {
+  // Incognito profiles have their own HostContentSettingsMap
+  return chrome::GetBrowserContextOwnInstanceInIncognito(context);
+}
+
+}  // namespace brave_shields
@@ -3,6 +3,11 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
+#include "base/barrier_closure.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/path_service.h"
 #include "base/scoped_observer.h"
 #include "brave/browser/brave_wallet/brave_wallet_service_factory.h"
@@ -62,6 +67,72 @@ std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
   return std::move(http_response);
 }
 
+// Answers each eth_getBalance in a batch with the address it was asked for.
+std::unique_ptr<net::test_server::HttpResponse> HandleBatchRequest(
+    const net::test_server::HttpRequest& request) {
+  base::Optional<base::Value> batch = base::JSONReader::Read(request.content);
+  if (!batch || !batch->is_list())
+    return nullptr;
+
+  base::Value responses(base::Value::Type::LIST);
+  for (const auto& rpc : batch->GetList()) {
+    base::Value response(base::Value::Type::DICTIONARY);
+    response.SetKey("jsonrpc", base::Value("2.0"));
+    response.SetKey("id", rpc.FindKey("id")->Clone());
+    response.SetKey("result", rpc.FindListKey("params")->GetList()[0].Clone());
+    responses.Append(std::move(response));
+  }
+
+  std::unique_ptr<net::test_server::BasicHttpResponse> http_response(
+      new net::test_server::BasicHttpResponse());
+  http_response->set_code(net::HTTP_OK);
+  http_response->set_content_type("application/json");
+  std::string content;
+  base::JSONWriter::Write(responses, &content);
+  http_response->set_content(content);
+  return std::move(http_response);
+}
+
+// Like HandleBatchRequest, but answers |kErrorAddress| with a JSON-RPC error
+// in the same batch.
+const char kErrorAddress[] = "0x4e02f254184E904300e0775E4b8eeCB9";
+
+std::unique_ptr<net::test_server::HttpResponse> HandleBatchRequestWithError(
+    const net::test_server::HttpRequest& request) {
+  base::Optional<base::Value> batch = base::JSONReader::Read(request.content);
+  if (!batch || !batch->is_list())
+    return nullptr;
+
+  base::Value responses(base::Value::Type::LIST);
+  for (const auto& rpc : batch->GetList()) {
+    const base::Value& address = rpc.FindListKey("params")->GetList()[0];
+    base::Value response(base::Value::Type::DICTIONARY);
+    response.SetKey("jsonrpc", base::Value("2.0"));
+    response.SetKey("id", rpc.FindKey("id")->Clone());
+    if (address.GetString() == kErrorAddress) {
+      base::Value error(base::Value::Type::DICTIONARY);
+      error.SetIntKey("code", -32005);
+      error.SetStringKey("message", "daily request count exceeded");
+      response.SetKey("error", std::move(error));
+    } else {
+      response.SetKey("result", address.Clone());
+    }
+    responses.Append(std::move(response));
+  }
+
+  std::unique_ptr<net::test_server::BasicHttpResponse> http_response(
+      new net::test_server::BasicHttpResponse());
+  http_response->set_code(net::HTTP_OK);
+  http_response->set_content_type("application/json");
+  std::string content;
+  base::JSONWriter::Write(responses, &content);
+  http_response->set_content(content);
+  return std::move(http_response);
+}
+
+// Served by the same test server, but a distinct network url.
+const char kOtherNetworkPath[] = "/other";
+
 std::unique_ptr<net::test_server::HttpResponse> HandleRequestServerError(
     const net::test_server::HttpRequest& request) {
   std::unique_ptr<net::test_server::BasicHttpResponse> http_response(
@@ -132,6 +203,48 @@ class EthJsonRpcBrowserTest : public InProcessBrowserTest {
     ASSERT_EQ(expected_success_, success);
   }
 
+  std::unique_ptr<net::test_server::HttpResponse>
+  HandleCountedUnstoppableDomainsRequest(
+      const net::test_server::HttpRequest& request) {
+    requests_++;
+    return HandleUnstoppableDomainsRequest(request);
+  }
+
+  std::unique_ptr<net::test_server::HttpResponse> HandleCountedRequest(
+      const net::test_server::HttpRequest& request) {
+    requests_++;
+    if (request.relative_url == kOtherNetworkPath)
+      other_network_requests_++;
+    return HandleRequest(request);
+  }
+
+  std::unique_ptr<net::test_server::HttpResponse>
+  HandleCountedRequestServerError(
+      const net::test_server::HttpRequest& request) {
+    requests_++;
+    return HandleRequestServerError(request);
+  }
+
+  std::unique_ptr<net::test_server::HttpResponse> HandleCountedBatchRequest(
+      const net::test_server::HttpRequest& request) {
+    requests_++;
+    return HandleBatchRequest(request);
+  }
+
+  std::unique_ptr<net::test_server::HttpResponse>
+  HandleCountedBatchRequestWithError(
+      const net::test_server::HttpRequest& request) {
+    requests_++;
+    return HandleBatchRequestWithError(request);
+  }
+
+  int requests() const { return requests_; }
+  int other_network_requests() const { return other_network_requests_; }
+
+  GURL other_network_url() {
+    return https_server()->GetURL(kOtherNetworkPath);
+  }
+
   void OnUnstoppableDomainsProxyReaderGetMany(bool success,
                                               const std::string& result) {
     if (wait_for_request_) {
@@ -176,6 +289,9 @@ class EthJsonRpcBrowserTest : public InProcessBrowserTest {
 
   std::unique_ptr<base::RunLoop> wait_for_request_;
   std::unique_ptr<net::EmbeddedTestServer> https_server_;
+  // Incremented on the test server's IO thread.
+  std::atomic<int> requests_{0};
+  std::atomic<int> other_network_requests_{0};
 };
 
 IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest, Request) {
@@ -283,3 +399,202 @@ IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest,
 
   WaitForResponse("", false);
 }
+
+IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest,
+                       UnstoppableDomainsProxyReaderGetManyCached) {
+  ResetHTTPSServer(base::BindRepeating(
+      &EthJsonRpcBrowserTest::HandleCountedUnstoppableDomainsRequest,
+      base::Unretained(this)));
+  auto* controller = GetEthJsonRpcController();
+  const std::vector<std::string> keys = {
+      "dweb.ipfs.hash", "ipfs.html.value", "browser.redirect_url",
+      "ipfs.redirect_domain.value"};
+
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(3, run_loop.QuitClosure());
+  auto on_result = base::BindRepeating(
+      [](base::RepeatingClosure done, bool success, const std::string& result) {
+        EXPECT_TRUE(success);
+        EXPECT_FALSE(result.empty());
+        done.Run();
+      },
+      barrier);
+
+  // Two concurrent lookups share one eth_call.
+  EXPECT_TRUE(controller->UnstoppableDomainsProxyReaderGetMany(
+      "0xa6E7cEf2EDDEA66352Fd68E5915b60BDbb7309f5", "brave.crypto", keys,
+      on_result));
+  EXPECT_TRUE(controller->UnstoppableDomainsProxyReaderGetMany(
+      "0xa6E7cEf2EDDEA66352Fd68E5915b60BDbb7309f5", "brave.crypto", keys,
+      on_result));
+  // A different domain is resolved separately.
+  EXPECT_TRUE(controller->UnstoppableDomainsProxyReaderGetMany(
+      "0xa6E7cEf2EDDEA66352Fd68E5915b60BDbb7309f5", "brave2.crypto", keys,
+      on_result));
+  run_loop.Run();
+  EXPECT_EQ(requests(), 2);
+
+  // Repeating a lookup is answered from the cache.
+  EXPECT_TRUE(controller->UnstoppableDomainsProxyReaderGetMany(
+      "0xa6E7cEf2EDDEA66352Fd68E5915b60BDbb7309f5", "brave.crypto", keys,
+      base::BindOnce(
+          &EthJsonRpcBrowserTest::OnUnstoppableDomainsProxyReaderGetMany,
+          base::Unretained(this))));
+  WaitForResponse(
+      "0x0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000004"
+      "0000000000000000000000000000000000000000000000000000000000000080"
+      "00000000000000000000000000000000000000000000000000000000000000a0"
+      "0000000000000000000000000000000000000000000000000000000000000100"
+      "0000000000000000000000000000000000000000000000000000000000000120"
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "000000000000000000000000000000000000000000000000000000000000002e"
+      "516d5772644e4a574d62765278787a4c686f6a564b614244737753344b4e564d"
+      "374c766a734e3751624472766b61000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      true);
+  EXPECT_EQ(requests(), 2);
+}
+
+IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest,
+                       UnstoppableDomainsProxyReaderGetManyErrorNotCached) {
+  ResetHTTPSServer(base::BindRepeating(
+      &EthJsonRpcBrowserTest::HandleCountedRequestServerError,
+      base::Unretained(this)));
+  auto* controller = GetEthJsonRpcController();
+  const std::vector<std::string> keys = {
+      "dweb.ipfs.hash", "ipfs.html.value", "browser.redirect_url",
+      "ipfs.redirect_domain.value"};
+
+  EXPECT_TRUE(controller->UnstoppableDomainsProxyReaderGetMany(
+      "0xa6E7cEf2EDDEA66352Fd68E5915b60BDbb7309f5", "brave.crypto", keys,
+      base::BindOnce(
+          &EthJsonRpcBrowserTest::OnUnstoppableDomainsProxyReaderGetMany,
+          base::Unretained(this))));
+  WaitForResponse("", false);
+  EXPECT_EQ(requests(), 1);
+
+  // A failed request says nothing about the domain, so it is sent again.
+  EXPECT_TRUE(controller->UnstoppableDomainsProxyReaderGetMany(
+      "0xa6E7cEf2EDDEA66352Fd68E5915b60BDbb7309f5", "brave.crypto", keys,
+      base::BindOnce(
+          &EthJsonRpcBrowserTest::OnUnstoppableDomainsProxyReaderGetMany,
+          base::Unretained(this))));
+  WaitForResponse("", false);
+  EXPECT_EQ(requests(), 2);
+}
+
+IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest, GetBalanceBatched) {
+  ResetHTTPSServer(
+      base::BindRepeating(&EthJsonRpcBrowserTest::HandleCountedBatchRequest,
+                          base::Unretained(this)));
+  auto* controller = GetEthJsonRpcController();
+  const std::vector<std::string> addresses = {
+      "0x4e02f254184E904300e0775E4b8eeCB1",
+      "0x4e02f254184E904300e0775E4b8eeCB2",
+      "0x4e02f254184E904300e0775E4b8eeCB3"};
+
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(addresses.size(), run_loop.QuitClosure());
+  for (const auto& address : addresses) {
+    controller->GetBalance(
+        address, base::BindOnce(
+                     [](const std::string& expected_balance,
+                        base::RepeatingClosure done, bool success,
+                        const std::string& balance) {
+                       EXPECT_TRUE(success);
+                       EXPECT_EQ(balance, expected_balance);
+                       done.Run();
+                     },
+                     address, barrier));
+  }
+  run_loop.Run();
+  EXPECT_EQ(requests(), 1);
+
+  // The balance is still fresh, so it is answered from the cache.
+  controller->GetBalance(addresses[1],
+                         base::BindOnce(&EthJsonRpcBrowserTest::OnGetBalance,
+                                        base::Unretained(this)));
+  WaitForResponse(addresses[1], true);
+  EXPECT_EQ(requests(), 1);
+}
+
+IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest,
+                       GetBalanceBatchedSentToQueuedNetwork) {
+  ResetHTTPSServer(
+      base::BindRepeating(&EthJsonRpcBrowserTest::HandleCountedRequest,
+                          base::Unretained(this)));
+  auto* controller = GetEthJsonRpcController();
+
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(2, run_loop.QuitClosure());
+  auto on_balance = base::BindRepeating(
+      [](base::RepeatingClosure done, bool success,
+         const std::string& balance) {
+        EXPECT_TRUE(success);
+        EXPECT_EQ(balance, "0xb539d5");
+        done.Run();
+      },
+      barrier);
+
+  // Switching networks while a read is queued sends it to the network it was
+  // queued for, and the new read separately to the new one.
+  controller->GetBalance("0x4e02f254184E904300e0775E4b8eeCB1", on_balance);
+  controller->SetCustomNetwork(other_network_url());
+  controller->GetBalance("0x4e02f254184E904300e0775E4b8eeCB1", on_balance);
+  run_loop.Run();
+  EXPECT_EQ(requests(), 2);
+  EXPECT_EQ(other_network_requests(), 1);
+}
+
+IN_PROC_BROWSER_TEST_F(EthJsonRpcBrowserTest, GetBalanceBatchedErrorNotCached) {
+  ResetHTTPSServer(base::BindRepeating(
+      &EthJsonRpcBrowserTest::HandleCountedBatchRequestWithError,
+      base::Unretained(this)));
+  auto* controller = GetEthJsonRpcController();
+  const std::string address = "0x4e02f254184E904300e0775E4b8eeCB1";
+
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(2, run_loop.QuitClosure());
+  controller->GetBalance(
+      address, base::BindOnce(
+                   [](const std::string& expected_balance,
+                      base::RepeatingClosure done, bool success,
+                      const std::string& balance) {
+                     EXPECT_TRUE(success);
+                     EXPECT_EQ(balance, expected_balance);
+                     done.Run();
+                   },
+                   address, barrier));
+  controller->GetBalance(
+      kErrorAddress,
+      base::BindOnce(
+          [](base::RepeatingClosure done, bool success,
+             const std::string& balance) {
+            EXPECT_FALSE(success);
+            EXPECT_EQ(balance, "");
+            done.Run();
+          },
+          barrier));
+  run_loop.Run();
+  EXPECT_EQ(requests(), 1);
+
+  // The result is answered from the cache.
+  controller->GetBalance(address,
+                         base::BindOnce(&EthJsonRpcBrowserTest::OnGetBalance,
+                                        base::Unretained(this)));
+  WaitForResponse(address, true);
+  EXPECT_EQ(requests(), 1);
+
+  // The error is not, it is sent to the node again.
+  controller->GetBalance(kErrorAddress,
+                         base::BindOnce(&EthJsonRpcBrowserTest::OnGetBalance,
+                                        base::Unretained(this)));
+  WaitForResponse("", false);
+  EXPECT_EQ(requests(), 2);
+}
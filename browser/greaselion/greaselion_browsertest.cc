@@ -3,6 +3,9 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <vector>
+
 #include "base/containers/flat_map.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
@@ -23,6 +26,7 @@
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -354,6 +358,37 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsGreaselionExtension) {
   EXPECT_TRUE(greaselion_service->IsGreaselionExtension(extension_ids[0]));
 }
 
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest,
+                       UnrelatedFeatureToggleKeepsExtensionsLoaded) {
+  ASSERT_TRUE(InstallMockExtension());
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  ASSERT_TRUE(greaselion_service);
+  extensions::ExtensionRegistry* registry =
+      extensions::ExtensionRegistry::Get(profile());
+
+  auto extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  ASSERT_GT(extension_ids.size(), 0UL);
+  std::vector<const extensions::Extension*> extensions;
+  for (const auto& id : extension_ids)
+    extensions.push_back(registry->enabled_extensions().GetByID(id));
+
+  // None of the test rules depend on ads, so nothing should be reloaded
+  greaselion_service->SetFeatureEnabled(greaselion::ADS, true);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+
+  auto new_extension_ids = greaselion_service->GetExtensionIdsForTesting();
+  std::sort(extension_ids.begin(), extension_ids.end());
+  std::sort(new_extension_ids.begin(), new_extension_ids.end());
+  EXPECT_EQ(extension_ids, new_extension_ids);
+  for (const extensions::Extension* extension : extensions) {
+    ASSERT_TRUE(extension);
+    EXPECT_EQ(extension,
+              registry->enabled_extensions().GetByID(extension->id()));
+  }
+}
+
 IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, IsNotGreaselionExtension) {
   ASSERT_TRUE(InstallMockExtension());
 
@@ -35,6 +35,8 @@ class BraveExternalProcessImporterClient
   void Cancel() override;
   void CloseMojoHandles() override;
   void OnImportItemFinished(importer::ImportItem import_item) override;
+  void OnHistoryImportStart(uint32_t total_history_rows_count) override;
+  void OnFaviconsImportStart(uint32_t total_favicons_count) override;
 
   // brave::mojom::ProfileImportObserver overrides:
   void OnCreditCardImportReady(
@@ -3,6 +3,9 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <atomic>
+
+#include "base/barrier_closure.h"
 #include "base/base64.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
@@ -98,6 +101,15 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     return http_response;
   }
 
+  std::unique_ptr<net::test_server::HttpResponse>
+  HandleCountedGetConnectedPeers(const net::test_server::HttpRequest& request) {
+    if (request.GetURL().path_piece() == kSwarmPeersPath)
+      swarm_peers_requests_++;
+    return HandleGetConnectedPeers(request);
+  }
+
+  int swarm_peers_requests() const { return swarm_peers_requests_; }
+
   std::unique_ptr<net::test_server::HttpResponse> HandleGetAddressesConfig(
       const net::test_server::HttpRequest& request) {
     const GURL gurl = request.GetURL();
@@ -301,6 +313,14 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
     EXPECT_EQ(peers, GetExpectedPeers());
   }
 
+  void OnGetConnectedPeersShared(base::OnceClosure done,
+                                 bool success,
+                                 const std::vector<std::string>& peers) {
+    EXPECT_TRUE(success);
+    EXPECT_EQ(peers, GetExpectedPeers());
+    std::move(done).Run();
+  }
+
   void OnGetConnectedPeersFail(bool success,
                                const std::vector<std::string>& peers) {
     if (wait_for_request_) {
@@ -410,6 +430,8 @@ class IpfsServiceBrowserTest : public InProcessBrowserTest {
   std::unique_ptr<base::RunLoop> wait_for_request_;
   std::unique_ptr<net::EmbeddedTestServer> test_server_;
   IpfsService* ipfs_service_;
+  // Incremented on the test server's IO thread.
+  std::atomic<int> swarm_peers_requests_{0};
   base::test::ScopedFeatureList feature_list_;
 };
 
@@ -423,6 +445,32 @@ IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetConnectedPeers) {
   WaitForRequest();
 }
 
+IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetConnectedPeersCoalesced) {
+  ResetTestServer(base::BindRepeating(
+      &IpfsServiceBrowserTest::HandleCountedGetConnectedPeers,
+      base::Unretained(this)));
+
+  base::RunLoop run_loop;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(3, run_loop.QuitClosure());
+  for (int i = 0; i < 3; i++) {
+    ipfs_service()->GetConnectedPeers(
+        base::BindOnce(&IpfsServiceBrowserTest::OnGetConnectedPeersShared,
+                       base::Unretained(this), barrier));
+  }
+  run_loop.Run();
+  EXPECT_EQ(swarm_peers_requests(), 1);
+  EXPECT_TRUE(ipfs_service()->HasCachedConnectedPeers());
+
+  // Answered from the cache without another round trip to the daemon.
+  base::RunLoop cached_run_loop;
+  ipfs_service()->GetConnectedPeers(
+      base::BindOnce(&IpfsServiceBrowserTest::OnGetConnectedPeersShared,
+                     base::Unretained(this), cached_run_loop.QuitClosure()));
+  cached_run_loop.Run();
+  EXPECT_EQ(swarm_peers_requests(), 1);
+}
+
 IN_PROC_BROWSER_TEST_F(IpfsServiceBrowserTest, GetConnectedPeersServerError) {
   ResetTestServer(
       base::BindRepeating(&IpfsServiceBrowserTest::HandleRequestServerError,
@@ -8,13 +8,12 @@
 #include <memory>
 #include <string>
 
-#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/browser/brave_shields/shields_settings_snapshot_cache_factory.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_settings_snapshot_cache.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
-#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
-#include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
 
@@ -135,22 +134,25 @@ std::shared_ptr<brave::BraveRequestInfo> BraveRequestInfo::MakeCTX(
   }
 #endif
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(map, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
-  ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
+  // Every request of a page shares one snapshot of the page's settings.
+  auto* shields_settings =
+      brave_shields::ShieldsSettingsSnapshotCacheFactory::GetForBrowserContext(
+          browser_context);
+  const brave_shields::ShieldsSettingsSnapshot tab_settings =
+      shields_settings->GetSnapshot(ctx->tab_origin);
+  ctx->allow_brave_shields = tab_settings.shields_enabled;
+  ctx->allow_ads = tab_settings.allow_ads;
+  ctx->allow_http_upgradable_resource = !tab_settings.https_everywhere_enabled;
 
   // HACK: after we fix multiple creations of BraveRequestInfo we should
   // use only tab_origin. Since we recreate BraveRequestInfo during consequent
   // stages of navigation, |tab_origin| changes and so does |allow_referrers|
   // flag, which is not what we want for determining referrers.
-  ctx->allow_referrers = brave_shields::AllowReferrers(
-      map,
-      ctx->redirect_source.is_empty() ? ctx->tab_origin : ctx->redirect_source);
+  ctx->allow_referrers =
+      ctx->redirect_source.is_empty()
+          ? tab_settings.allow_referrers
+          : shields_settings->GetSnapshot(ctx->redirect_source)
+                .allow_referrers;
   ctx->upload_data = GetUploadData(request);
 
   ctx->browser_context = browser_context;
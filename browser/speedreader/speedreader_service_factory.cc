@@ -5,7 +5,10 @@
 
 #include "brave/browser/speedreader/speedreader_service_factory.h"
 
+#include "brave/components/speedreader/speedreader_pref_names.h"
 #include "brave/components/speedreader/speedreader_service.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "chrome/browser/profiles/incognito_helpers.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/keyed_service/content/browser_context_dependency_manager.h"
@@ -26,7 +29,9 @@ SpeedreaderService* SpeedreaderServiceFactory::GetForProfile(Profile* profile) {
 SpeedreaderServiceFactory::SpeedreaderServiceFactory()
     : BrowserContextKeyedServiceFactory(
           "SpeedreaderService",
-          BrowserContextDependencyManager::GetInstance()) {}
+          BrowserContextDependencyManager::GetInstance()) {
+  DependsOn(WeeklyStorageRegistryFactory::GetInstance());
+}
 
 SpeedreaderServiceFactory::~SpeedreaderServiceFactory() {}
 
@@ -39,7 +44,9 @@ SpeedreaderServiceFactory::GetBrowserContextToUse(
 KeyedService* SpeedreaderServiceFactory::BuildServiceInstanceFor(
     content::BrowserContext* context) const {
   return new SpeedreaderService(
-      Profile::FromBrowserContext(context)->GetPrefs());
+      Profile::FromBrowserContext(context)->GetPrefs(),
+      WeeklyStorageRegistryFactory::GetForBrowserContext(context)->Get(
+          kSpeedreaderPrefToggleCount));
 }
 
 bool SpeedreaderServiceFactory::ServiceIsCreatedWithBrowserContext() const {
@@ -142,6 +142,8 @@ void RewardsInternalsDOMHandler::OnGetRewardsInternalsInfo(
     info_dict.SetString("walletPaymentId", info->payment_id);
     info_dict.SetBoolean("isKeyInfoSeedValid", info->is_key_info_seed_valid);
     info_dict.SetInteger("bootStamp", info->boot_stamp);
+    info_dict.SetDouble("mediaResolverHits", info->media_resolver_hits);
+    info_dict.SetDouble("mediaResolverMisses", info->media_resolver_misses);
   }
   web_ui()->CallJavascriptFunctionUnsafe(
       "brave_rewards_internals.onGetRewardsInternalsInfo", info_dict);
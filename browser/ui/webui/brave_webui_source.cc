@@ -1031,6 +1031,7 @@ void CustomizeWebUIHTMLSource(const std::string &name,
         { "keyInfoSeed", IDS_BRAVE_REWARDS_INTERNALS_KEY_INFO_SEED },
         { "logNotice", IDS_BRAVE_REWARDS_INTERNALS_LOG_NOTICE },
         { "mainTitle", IDS_BRAVE_REWARDS_INTERNALS_MAIN_TITLE },
+        { "mediaResolverHitRate", IDS_BRAVE_REWARDS_INTERNALS_MEDIA_RESOLVER_HIT_RATE },  // NOLINT
         { "personaId", IDS_BRAVE_REWARDS_INTERNALS_PERSONA_ID },
         { "processorBraveTokens", IDS_BRAVE_UI_PROCESSOR_BRAVE_TOKENS },
         { "processorUphold", IDS_BRAVE_UI_PROCESSOR_UPHOLD },
@@ -27,6 +27,8 @@
 #include "brave/components/ntp_background_images/common/pref_names.h"
 #include "brave/components/p3a/brave_p3a_utils.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/common/chrome_features.h"
@@ -554,10 +556,11 @@ void BraveNewTabMessageHandler::HandleTodayInteractionBegin(
   UMA_HISTOGRAM_EXACT_LINEAR("Brave.Today.HasEverInteracted", 1, 1);
   // Track how many times in the past week
   // user has scrolled to Brave Today.
-  WeeklyStorage session_count_storage(
-      profile_->GetPrefs(), kBraveTodayWeeklySessionCount);
-  session_count_storage.AddDelta(1);
-  uint64_t total_session_count = session_count_storage.GetWeeklySum();
+  WeeklyStorage* session_count_storage =
+      WeeklyStorageRegistryFactory::GetForBrowserContext(profile_)->Get(
+          kBraveTodayWeeklySessionCount);
+  session_count_storage->AddDelta(1);
+  uint64_t total_session_count = session_count_storage->GetWeeklySum();
   constexpr int kSessionCountBuckets[] = {0, 1, 3, 7, 12, 18, 25, 1000};
   const int* it_count =
       std::lower_bound(kSessionCountBuckets, std::end(kSessionCountBuckets),
@@ -577,11 +580,12 @@ void BraveNewTabMessageHandler::HandleTodayOnCardVisit(
   int cards_visited_total = args->GetList()[0].GetInt();
   // Track how many Brave Today cards have been viewed per session
   // (each NTP / NTP Message Handler is treated as 1 session).
-  WeeklyStorage storage(
-      profile_->GetPrefs(), kBraveTodayWeeklyCardVisitsCount);
-  storage.ReplaceTodaysValueIfGreater(cards_visited_total);
+  WeeklyStorage* storage =
+      WeeklyStorageRegistryFactory::GetForBrowserContext(profile_)->Get(
+          kBraveTodayWeeklyCardVisitsCount);
+  storage->ReplaceTodaysValueIfGreater(cards_visited_total);
   // Send the session with the highest count of cards viewed.
-  uint64_t total = storage.GetHighestValueInWeek();
+  uint64_t total = storage->GetHighestValueInWeek();
   constexpr int kBuckets[] = {0, 1, 3, 6, 10, 15, 100};
   const int* it_count =
       std::lower_bound(kBuckets, std::end(kBuckets),
@@ -610,11 +614,12 @@ void BraveNewTabMessageHandler::HandleTodayOnCardViews(
   int cards_viewed_total = args->GetList()[0].GetInt();
   // Track how many Brave Today cards have been viewed per session
   // (each NTP / NTP Message Handler is treated as 1 session).
-  WeeklyStorage storage(
-      profile_->GetPrefs(), kBraveTodayWeeklyCardViewsCount);
-  storage.ReplaceTodaysValueIfGreater(cards_viewed_total);
+  WeeklyStorage* storage =
+      WeeklyStorageRegistryFactory::GetForBrowserContext(profile_)->Get(
+          kBraveTodayWeeklyCardViewsCount);
+  storage->ReplaceTodaysValueIfGreater(cards_viewed_total);
   // Send the session with the highest count of cards viewed.
-  uint64_t total = storage.GetHighestValueInWeek();
+  uint64_t total = storage->GetHighestValueInWeek();
   constexpr int kBuckets[] = {0, 1, 4, 12, 20, 40, 80, 1000};
   const int* it_count =
       std::lower_bound(kBuckets, std::end(kBuckets),
@@ -7,6 +7,7 @@
 
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
@@ -31,28 +32,6 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
-
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
-}
-
 }  // namespace
 
 namespace brave {
@@ -130,7 +109,7 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarblingHelper BraveSessionCache::GetAudioFarblingHelper(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -143,15 +122,15 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarblingHelper::ConstantMultiplier(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarblingHelper::PseudoRandomSequence(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarblingHelper();
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
@@ -179,7 +158,7 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
     return;
 
   uint8_t* pixels = const_cast<uint8_t*>(data);
-  // This needs to be type size_t because we pass it to base::StringPiece
+  // This needs to be type size_t because we pass it to base::make_span
   // later for content hashing. This is safe because the maximum canvas
   // dimensions are less than SIZE_T_MAX. (Width and height are each
   // limited to 32,767 pixels.)
@@ -187,15 +166,11 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
   const size_t pixel_count = size / 4;
   // calculate initial seed to find first pixel to perturb, based on session
   // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
   uint64_t session_plus_domain_key =
       session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
-               canvas_key, sizeof canvas_key));
-  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
+  const CanvasFarblingKey canvas_key = MakeCanvasFarblingKey(
+      session_plus_domain_key, base::make_span(data, size));
+  uint64_t v = *reinterpret_cast<const uint64_t*>(canvas_key.data());
   uint64_t pixel_index;
   // choose which channel (R, G, or B) to perturb
   uint8_t channel;
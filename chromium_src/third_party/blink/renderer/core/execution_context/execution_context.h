@@ -10,7 +10,7 @@
 
 #include <random>
 
-#include "base/callback.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbling_helper.h"
 
 namespace blink {
 class WebContentSettingsClient;
@@ -26,8 +26,6 @@ using blink::TraceTrait;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
-
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
 
@@ -42,7 +40,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
+  AudioFarblingHelper GetAudioFarblingHelper(
       blink::WebContentSettingsClient* settings);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
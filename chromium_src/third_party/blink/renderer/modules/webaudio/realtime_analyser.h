@@ -6,10 +6,11 @@
 #ifndef BRAVE_CHROMIUM_SRC_THIRD_PARTY_BLINK_RENDERER_MODULES_WEBAUDIO_REALTIME_ANALYSER_H_
 #define BRAVE_CHROMIUM_SRC_THIRD_PARTY_BLINK_RENDERER_MODULES_WEBAUDIO_REALTIME_ANALYSER_H_
 
-#include "base/callback.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbling_helper.h"
 
-#define BRAVE_REALTIMEANALYSER_H \
-  base::RepeatingCallback<float(float, size_t)> audio_farbling_callback_;
+#define BRAVE_REALTIMEANALYSER_H                   \
+  brave::AudioFarblingHelper audio_farbling_helper_; \
+  uint64_t audio_farbling_state_ = 0;
 
 #include "../../../../../../../third_party/blink/renderer/modules/webaudio/realtime_analyser.h"
 
@@ -0,0 +1,300 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/path_service.h"
+#include "base/process/process_metrics.h"
+#include "base/strings/string_split.h"
+#include "base/time/time.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// npm run test -- adblock_rust_ffi_perftests --filter=AdBlockEnginePerfTest.*
+//
+// The fixtures in brave/test/data/adblock-perf can be replaced with full
+// lists with --adblock-filter-list=<path> and --adblock-request-corpus=<path>
+
+using net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES;
+using net::registry_controlled_domains::SameDomainOrHost;
+
+namespace adblock {
+
+namespace {
+
+const char kFilterListSwitch[] = "adblock-filter-list";
+const char kRequestCorpusSwitch[] = "adblock-request-corpus";
+const char kSerializedEngineSwitch[] = "adblock-dat";
+
+// Passes over the request corpus for the per request operations
+const int kIterations = 50;
+// Engines built or deserialized for the per engine operations
+const int kEngineIterations = 10;
+// Calls for the operations which don't depend on the request corpus
+const int kSelectorIterations = 5000;
+
+const char* const kClasses[] = {"ad-banner", "ad-container", "adsbygoogle",
+                                "article",   "content",      "footer",
+                                "header",    "nav",          "sponsored",
+                                "text-ad"};
+const char* const kIds[] = {"ad-header", "ad-sidebar", "banner-ad", "main",
+                            "sidebar"};
+
+constexpr char kMetricPrefix[] = "AdBlockEngine.";
+constexpr char kMetricLatencyP50[] = "latency_p50";
+constexpr char kMetricLatencyP90[] = "latency_p90";
+constexpr char kMetricLatencyP99[] = "latency_p99";
+constexpr char kMetricLatencyMax[] = "latency_max";
+constexpr char kMetricMemory[] = "memory";
+
+struct Request {
+  std::string url;
+  std::string host;
+  std::string tab_url;
+  std::string tab_host;
+  bool is_third_party = false;
+  std::string resource_type;
+};
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricLatencyP50, "us");
+  reporter.RegisterImportantMetric(kMetricLatencyP90, "us");
+  reporter.RegisterImportantMetric(kMetricLatencyP99, "us");
+  reporter.RegisterFyiMetric(kMetricLatencyMax, "us");
+  reporter.RegisterImportantMetric(kMetricMemory, "bytes");
+  return reporter;
+}
+
+void ReportLatencies(perf_test::PerfResultReporter* reporter,
+                     std::vector<base::TimeDelta> latencies) {
+  ASSERT_FALSE(latencies.empty());
+  std::sort(latencies.begin(), latencies.end());
+
+  const auto percentile = [&latencies](const size_t percent) {
+    const size_t index = (latencies.size() - 1) * percent / 100;
+    return latencies[index].InMicrosecondsF();
+  };
+
+  reporter->AddResult(kMetricLatencyP50, percentile(50));
+  reporter->AddResult(kMetricLatencyP90, percentile(90));
+  reporter->AddResult(kMetricLatencyP99, percentile(99));
+  reporter->AddResult(kMetricLatencyMax, latencies.back().InMicrosecondsF());
+}
+
+size_t GetMallocUsage() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
+}
+
+// Average growth of the heap since |malloc_usage| for each of |count| live
+// engines
+size_t GetMemoryPerEngine(const size_t malloc_usage, const size_t count) {
+  const size_t current_malloc_usage = GetMallocUsage();
+  if (current_malloc_usage < malloc_usage || count == 0) {
+    return 0;
+  }
+
+  return (current_malloc_usage - malloc_usage) / count;
+}
+
+base::FilePath GetFixturePath(const char* switch_name,
+                              const base::FilePath::StringPieceType& path) {
+  const base::CommandLine* command_line =
+      base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch(switch_name)) {
+    return command_line->GetSwitchValuePath(switch_name);
+  }
+
+  base::FilePath test_data_path;
+  base::PathService::Get(base::DIR_SOURCE_ROOT, &test_data_path);
+  return test_data_path.Append(FILE_PATH_LITERAL("brave"))
+      .Append(FILE_PATH_LITERAL("test"))
+      .Append(FILE_PATH_LITERAL("data"))
+      .Append(path);
+}
+
+std::string ReadFixture(const char* switch_name,
+                        const base::FilePath::StringPieceType& path) {
+  const base::FilePath fixture_path = GetFixturePath(switch_name, path);
+
+  std::string contents;
+  if (!base::ReadFileToString(fixture_path, &contents)) {
+    ADD_FAILURE() << "Failed to read " << fixture_path.value();
+  }
+
+  return contents;
+}
+
+std::string ReadFilterList() {
+  return ReadFixture(kFilterListSwitch,
+                     FILE_PATH_LITERAL("adblock-perf/filter_list.txt"));
+}
+
+std::string ReadSerializedEngine() {
+  return ReadFixture(kSerializedEngineSwitch,
+                     FILE_PATH_LITERAL("adblock-data/adblock-default/"
+                                       "rs-ABPFilterParserData.dat"));
+}
+
+// Each line of the corpus is "<url> <source url> <resource type>". Third
+// party is decided the same way AdBlockBaseService does it.
+std::vector<Request> ReadRequestCorpus() {
+  const std::string corpus =
+      ReadFixture(kRequestCorpusSwitch,
+                  FILE_PATH_LITERAL("adblock-perf/request_corpus.txt"));
+
+  std::vector<Request> requests;
+  for (const auto& line : base::SplitStringPiece(
+           corpus, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (line[0] == '#') {
+      continue;
+    }
+
+    const std::vector<std::string> fields = base::SplitString(
+        line, " \t", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+    if (fields.size() != 3) {
+      continue;
+    }
+
+    const GURL url(fields[0]);
+    const GURL tab_url(fields[1]);
+    if (!url.is_valid() || !tab_url.is_valid()) {
+      continue;
+    }
+
+    Request request;
+    request.url = url.spec();
+    request.host = url.host();
+    request.tab_url = tab_url.spec();
+    request.tab_host = tab_url.host();
+    request.is_third_party =
+        !SameDomainOrHost(url, tab_url, INCLUDE_PRIVATE_REGISTRIES);
+    request.resource_type = fields[2];
+    requests.push_back(request);
+  }
+
+  EXPECT_FALSE(requests.empty());
+  return requests;
+}
+
+}  // namespace
+
+TEST(AdBlockEnginePerfTest, Parse) {
+  const std::string filter_list = ReadFilterList();
+
+  std::vector<base::TimeDelta> latencies;
+  std::vector<std::unique_ptr<Engine>> engines;
+  const size_t malloc_usage = GetMallocUsage();
+  for (int i = 0; i < kEngineIterations; i++) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    engines.push_back(std::make_unique<Engine>(filter_list));
+    latencies.push_back(base::TimeTicks::Now() - start);
+  }
+
+  perf_test::PerfResultReporter reporter = SetUpReporter("parse");
+  ReportLatencies(&reporter, latencies);
+  reporter.AddResult(kMetricMemory,
+                     GetMemoryPerEngine(malloc_usage, engines.size()));
+}
+
+TEST(AdBlockEnginePerfTest, Deserialize) {
+  const std::string dat = ReadSerializedEngine();
+  ASSERT_FALSE(dat.empty());
+
+  std::vector<base::TimeDelta> latencies;
+  std::vector<std::unique_ptr<Engine>> engines;
+  const size_t malloc_usage = GetMallocUsage();
+  for (int i = 0; i < kEngineIterations; i++) {
+    auto engine = std::make_unique<Engine>();
+    const base::TimeTicks start = base::TimeTicks::Now();
+    ASSERT_TRUE(engine->deserialize(dat.data(), dat.size()));
+    latencies.push_back(base::TimeTicks::Now() - start);
+    engines.push_back(std::move(engine));
+  }
+
+  perf_test::PerfResultReporter reporter = SetUpReporter("deserialize");
+  ReportLatencies(&reporter, latencies);
+  reporter.AddResult(kMetricMemory,
+                     GetMemoryPerEngine(malloc_usage, engines.size()));
+}
+
+TEST(AdBlockEnginePerfTest, Matches) {
+  Engine engine(ReadFilterList());
+  const std::vector<Request> requests = ReadRequestCorpus();
+
+  std::vector<base::TimeDelta> latencies;
+  latencies.reserve(requests.size() * kIterations);
+  for (int i = 0; i < kIterations; i++) {
+    for (const auto& request : requests) {
+      bool did_match_rule = false;
+      bool did_match_exception = false;
+      bool did_match_important = false;
+      std::string redirect;
+
+      const base::TimeTicks start = base::TimeTicks::Now();
+      engine.matches(request.url, request.host, request.tab_host,
+                     request.is_third_party, request.resource_type,
+                     &did_match_rule, &did_match_exception,
+                     &did_match_important, &redirect);
+      latencies.push_back(base::TimeTicks::Now() - start);
+    }
+  }
+
+  perf_test::PerfResultReporter reporter = SetUpReporter("matches");
+  ReportLatencies(&reporter, latencies);
+}
+
+TEST(AdBlockEnginePerfTest, UrlCosmeticResources) {
+  Engine engine(ReadFilterList());
+  const std::vector<Request> requests = ReadRequestCorpus();
+
+  std::vector<base::TimeDelta> latencies;
+  latencies.reserve(requests.size() * kIterations);
+  for (int i = 0; i < kIterations; i++) {
+    for (const auto& request : requests) {
+      const base::TimeTicks start = base::TimeTicks::Now();
+      engine.urlCosmeticResources(request.tab_url);
+      latencies.push_back(base::TimeTicks::Now() - start);
+    }
+  }
+
+  perf_test::PerfResultReporter reporter =
+      SetUpReporter("url_cosmetic_resources");
+  ReportLatencies(&reporter, latencies);
+}
+
+TEST(AdBlockEnginePerfTest, HiddenClassIdSelectors) {
+  Engine engine(ReadFilterList());
+
+  const std::vector<std::string> classes(std::begin(kClasses),
+                                         std::end(kClasses));
+  const std::vector<std::string> ids(std::begin(kIds), std::end(kIds));
+  const std::vector<std::string> exceptions;
+
+  std::vector<base::TimeDelta> latencies;
+  latencies.reserve(kSelectorIterations);
+  for (int i = 0; i < kSelectorIterations; i++) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    engine.hiddenClassIdSelectors(classes, ids, exceptions);
+    latencies.push_back(base::TimeTicks::Now() - start);
+  }
+
+  perf_test::PerfResultReporter reporter =
+      SetUpReporter("hidden_class_id_selectors");
+  ReportLatencies(&reporter, latencies);
+}
+
+}  // namespace adblock
@@ -12,6 +12,7 @@
 #include "base/metrics/histogram_functions.h"
 #include "brave/components/brave_ads/common/pref_names.h"
 #include "brave/components/weekly_storage/weekly_storage.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 
@@ -94,16 +95,18 @@ void RegisterP2APrefs(PrefRegistrySimple* registry) {
   }
 }
 
-void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(PrefService* prefs,
-                                                    const std::string& name) {
+void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+    PrefService* prefs,
+    WeeklyStorageRegistry* weekly_storage_registry,
+    const std::string& name) {
   std::string pref_path(prefs::kP2AStoragePrefNamePrefix);
   pref_path.append(name);
   if (!prefs->FindPreference(pref_path)) {
     return;
   }
-  WeeklyStorage storage(prefs, pref_path.c_str());
-  storage.AddDelta(1);
-  EmitP2AHistogramAnswer(name, storage.GetWeeklySum());
+  WeeklyStorage* storage = weekly_storage_registry->Get(pref_path.c_str());
+  storage->AddDelta(1);
+  EmitP2AHistogramAnswer(name, storage->GetWeeklySum());
 }
 
 void EmitP2AHistogramAnswer(const std::string& name, uint16_t count_value) {
@@ -13,13 +13,18 @@
 
 class PrefService;
 class PrefRegistrySimple;
+class WeeklyStorageRegistry;
 
 namespace brave_ads {
 
 void RegisterP2APrefs(PrefRegistrySimple* prefs);
 
-void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(PrefService* prefs,
-                                                    const std::string& name);
+// Adds one to this week's count of |name| in the shared storage of
+// |weekly_storage_registry| and reports the new weekly sum.
+void RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+    PrefService* prefs,
+    WeeklyStorageRegistry* weekly_storage_registry,
+    const std::string& name);
 
 void EmitP2AHistogramAnswer(const std::string& name, uint16_t count_value);
 
@@ -89,9 +89,8 @@ class AdsService : public KeyedService {
 
   virtual void ChangeLocale(const std::string& locale) = 0;
 
-  virtual void OnHtmlLoaded(const SessionID& tab_id,
-                            const std::vector<GURL>& redirect_chain,
-                            const std::string& html) = 0;
+  virtual void OnPageLoaded(const SessionID& tab_id,
+                            const std::vector<GURL>& redirect_chain) = 0;
 
   virtual void OnTextLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
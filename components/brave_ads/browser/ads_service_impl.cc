@@ -60,6 +60,7 @@
 #include "brave/components/rpill/common/rpill.h"
 #include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/notifications/notification_display_service.h"
@@ -71,18 +72,23 @@
 #include "chrome/browser/fullscreen.h"
 #include "chrome/browser/ui/browser.h"
 #include "chrome/browser/ui/browser_finder.h"
+#include "chrome/browser/ui/browser_list.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
 #endif
 #include "chrome/browser/first_run/first_run.h"
 #include "chrome/browser/ui/browser_navigator_params.h"
 #include "chrome/common/buildflags.h"
 #include "chrome/common/chrome_constants.h"
+#include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
 #include "components/history/core/browser/history_service.h"
 #include "components/prefs/pref_service.h"
+#include "components/sessions/content/session_tab_helper.h"
 #include "components/wifi/wifi_service.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/network_service_instance.h"
 #include "content/public/browser/service_process_host.h"
 #include "content/public/browser/storage_partition.h"
+#include "content/public/browser/web_contents.h"
 #include "net/base/network_change_notifier.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
@@ -95,6 +101,7 @@
 #include "brave/browser/notifications/brave_notification_platform_bridge_helper_android.h"
 #include "chrome/browser/android/service_tab_launcher.h"
 #include "chrome/browser/android/tab_android.h"
+#include "chrome/browser/ui/android/tab_model/tab_model.h"
 #include "chrome/browser/ui/android/tab_model/tab_model_list.h"
 #include "content/public/browser/page_navigator.h"
 #endif
@@ -107,6 +114,44 @@ namespace {
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+content::WebContents* GetWebContentsForTab(Profile* profile,
+                                           const int32_t tab_id) {
+#if defined(OS_ANDROID)
+  for (auto iter = TabModelList::begin(); iter != TabModelList::end();
+       ++iter) {
+    TabModel* tab_model = *iter;
+    if (tab_model->GetProfile() != profile) {
+      continue;
+    }
+
+    for (int index = 0; index < tab_model->GetTabCount(); index++) {
+      content::WebContents* web_contents = tab_model->GetWebContentsAt(index);
+      if (web_contents &&
+          sessions::SessionTabHelper::IdForTab(web_contents).id() == tab_id) {
+        return web_contents;
+      }
+    }
+  }
+#else
+  for (Browser* browser : *BrowserList::GetInstance()) {
+    if (browser->profile() != profile) {
+      continue;
+    }
+
+    TabStripModel* tab_strip_model = browser->tab_strip_model();
+    for (int index = 0; index < tab_strip_model->count(); index++) {
+      content::WebContents* web_contents =
+          tab_strip_model->GetWebContentsAt(index);
+      if (sessions::SessionTabHelper::IdForTab(web_contents).id() == tab_id) {
+        return web_contents;
+      }
+    }
+  }
+#endif
+
+  return nullptr;
+}
+
 }  // namespace
 
 namespace {
@@ -309,9 +354,8 @@ void AdsServiceImpl::ChangeLocale(const std::string& locale) {
   bat_ads_->ChangeLocale(locale);
 }
 
-void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
-                                  const std::vector<GURL>& redirect_chain,
-                                  const std::string& html) {
+void AdsServiceImpl::OnPageLoaded(const SessionID& tab_id,
+                                  const std::vector<GURL>& redirect_chain) {
   if (!connected()) {
     return;
   }
@@ -321,7 +365,7 @@ void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
     redirect_chain_as_strings.push_back(url.spec());
   }
 
-  bat_ads_->OnHtmlLoaded(tab_id.id(), redirect_chain_as_strings, html);
+  bat_ads_->OnPageLoaded(tab_id.id(), redirect_chain_as_strings);
 }
 
 void AdsServiceImpl::OnTextLoaded(const SessionID& tab_id,
@@ -1956,6 +2000,39 @@ void AdsServiceImpl::OnBrowsingHistorySearchComplete(
   callback(history);
 }
 
+void AdsServiceImpl::GetHtmlHead(const int32_t tab_id,
+                                 const std::string& url,
+                                 ads::GetHtmlHeadCallback callback) {
+  content::WebContents* web_contents = GetWebContentsForTab(profile_, tab_id);
+  if (!web_contents || web_contents->GetLastCommittedURL() != GURL(url)) {
+    callback("");
+    return;
+  }
+
+  // Conversions only read meta tags from the head, so don't serialize the
+  // whole document
+  dom_distiller::RunIsolatedJavaScript(
+      web_contents->GetMainFrame(),
+      "document.head ? new XMLSerializer().serializeToString(document.head) "
+      ": ''",
+      base::BindOnce(&AdsServiceImpl::OnGetHtmlHead, AsWeakPtr(),
+                     std::move(callback)));
+}
+
+void AdsServiceImpl::OnGetHtmlHead(ads::GetHtmlHeadCallback callback,
+                                   base::Value value) {
+  if (!connected()) {
+    return;
+  }
+
+  std::string html;
+  if (value.is_string()) {
+    html = value.GetString();
+  }
+
+  callback(html);
+}
+
 void AdsServiceImpl::RecordP2AEvent(const std::string& name,
                                     const ads::P2AEventType type,
                                     const std::string& value) {
@@ -1971,9 +2048,11 @@ void AdsServiceImpl::RecordP2AEvent(const std::string& name,
         break;
       }
 
+      WeeklyStorageRegistry* weekly_storage_registry =
+          WeeklyStorageRegistryFactory::GetForBrowserContext(profile_);
       for (auto& item : *list) {
-        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(profile_->GetPrefs(),
-                                                       item.GetString());
+        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(
+            profile_->GetPrefs(), weekly_storage_registry, item.GetString());
       }
       break;
     }
@@ -18,6 +18,7 @@
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/timer/timer.h"
+#include "base/values.h"
 #include "bat/ads/ads.h"
 #include "bat/ads/ads_client.h"
 #include "bat/ads/database.h"
@@ -104,9 +105,8 @@ class AdsServiceImpl : public AdsService,
 
   void ChangeLocale(const std::string& locale) override;
 
-  void OnHtmlLoaded(const SessionID& tab_id,
-                    const std::vector<GURL>& redirect_chain,
-                    const std::string& html) override;
+  void OnPageLoaded(const SessionID& tab_id,
+                    const std::vector<GURL>& redirect_chain) override;
 
   void OnTextLoaded(const SessionID& tab_id,
                     const std::vector<GURL>& redirect_chain,
@@ -360,6 +360,12 @@ class AdsServiceImpl : public AdsService,
   void OnBrowsingHistorySearchComplete(ads::GetBrowsingHistoryCallback callback,
                                        history::QueryResults results);
 
+  void GetHtmlHead(const int32_t tab_id,
+                   const std::string& url,
+                   ads::GetHtmlHeadCallback callback) override;
+
+  void OnGetHtmlHead(ads::GetHtmlHeadCallback callback, base::Value value);
+
   std::string LoadResourceForId(const std::string& id) override;
 
   void RunDBTransaction(ads::DBTransactionPtr transaction,
@@ -65,11 +65,12 @@ class MockRewardsService : public RewardsService {
   MOCK_METHOD1(OnBackground, void(SessionID));
   MOCK_METHOD4(OnXHRLoad,
                void(SessionID, const GURL&, const GURL&, const GURL&));
-  MOCK_METHOD5(OnPostData,
+  MOCK_METHOD6(OnPostData,
                void(SessionID,
                     const GURL&,
                     const GURL&,
                     const GURL&,
+                    const std::string&,
                     const std::string&));
   MOCK_METHOD1(GetReconcileStamp,
                void(const brave_rewards::GetReconcileStampCallback&));
@@ -25,9 +25,9 @@ export const reportBrokenSite: actions.ReportBrokenSite = () => {
   }
 }
 
-export const resourceBlocked: actions.ResourceBlocked = (details) => {
+export const resourcesBlocked: actions.ResourcesBlocked = (details) => {
   return {
-    type: types.RESOURCE_BLOCKED,
+    type: types.RESOURCES_BLOCKED,
     details
   }
 }
@@ -6,8 +6,8 @@ import actions from '../actions/shieldsPanelActions'
 import { BlockDetails } from '../../types/actions/shieldsPanelActions'
 
 if (chrome.braveShields) {
-  chrome.braveShields.onBlocked.addListener((detail: BlockDetails) => {
-    actions.resourceBlocked(detail)
+  chrome.braveShields.onResourcesBlocked.addListener((details: BlockDetails[]) => {
+    actions.resourcesBlocked(details)
   })
 } else {
   console.log('chrome.braveShields not enabled')
@@ -181,16 +181,17 @@ export default function shieldsPanelReducer (
         })
       break
     }
-    case shieldsPanelTypes.RESOURCE_BLOCKED: {
-      const tabId: number = action.details.tabId
+    case shieldsPanelTypes.RESOURCES_BLOCKED: {
       const currentTabId: number = shieldsPanelState.getActiveTabId(state)
-      state = shieldsPanelState.updateResourceBlocked(
-        state, tabId, action.details.blockType, action.details.subresource)
-      if (tabId === currentTabId) {
-        const isShieldsActive: boolean = shieldsPanelState.isShieldsActive(state, tabId)
-        if (isShieldsActive) {
-          shieldsPanelState.updateShieldsIconBadgeText(state)
-        }
+      let currentTabUpdated: boolean = false
+      for (const details of action.details) {
+        state = shieldsPanelState.updateResourceBlocked(
+          state, details.tabId, details.blockType, details.subresource)
+        currentTabUpdated = currentTabUpdated || details.tabId === currentTabId
+      }
+      // Update the badge once per batch rather than once per resource
+      if (currentTabUpdated && shieldsPanelState.isShieldsActive(state, currentTabId)) {
+        shieldsPanelState.updateShieldsIconBadgeText(state)
       }
       break
     }
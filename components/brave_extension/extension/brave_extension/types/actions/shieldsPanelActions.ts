@@ -50,13 +50,13 @@ export interface ReportBrokenSite {
   (): ReportBrokenSiteReturn
 }
 
-interface ResourceBlockedReturn {
-  type: types.RESOURCE_BLOCKED
-  details: BlockDetails
+interface ResourcesBlockedReturn {
+  type: types.RESOURCES_BLOCKED
+  details: BlockDetails[]
 }
 
-export interface ResourceBlocked {
-  (details: BlockDetails): ResourceBlockedReturn
+export interface ResourcesBlocked {
+  (details: BlockDetails[]): ResourcesBlockedReturn
 }
 
 interface BlockAdsTrackersReturn {
@@ -212,7 +212,7 @@ export type shieldPanelActions =
   ShieldsPanelDataUpdatedReturn |
   ShieldsToggledReturn |
   ReportBrokenSiteReturn |
-  ResourceBlockedReturn |
+  ResourcesBlockedReturn |
   BlockAdsTrackersReturn |
   ControlsToggledReturn |
   HttpsEverywhereToggledReturn |
@@ -5,62 +5,34 @@
 
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg.h"
 
-#include <algorithm>
 #include <cmath>
-#include <numeric>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
+#include "base/no_destructor.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
 
-namespace {
-
-bool StandardiseFeatsNoOutliers(
-    std::array<double, standardise_feat_count>* features,
-    const std::array<double, standardise_feat_count>& means,
-    const std::array<double, standardise_feat_count>& scale) {
-  for (unsigned int i = 0; i < standardise_feat_count; i++) {
-    features->at(i) = (features->at(i) - means[i]) / scale[i];
-  }
+double LinregPredictVector(const std::array<double, feature_count>& features) {
+  // Standardise numeric features on the fly, folding them straight into the
+  // dot product with the model coefficients
+  double log_prediction = model_intercept;
   for (unsigned int i = 0; i < standardise_feat_count; i++) {
-    if (features->at(i) > kOutlierThreshold ||
-        features->at(i) < -kOutlierThreshold) {
+    const double feature =
+        (features[i] - standardise_feat_means[i]) / standardise_feat_scale[i];
+    if (feature > kOutlierThreshold || feature < -kOutlierThreshold) {
       VLOG(2) << "Outlier feature " << feature_sequence.at(i) << " with value "
-              << features->at(i);
-      return true;
+              << feature << ", return 0";
+      return 0;
     }
+    log_prediction += feature * model_coefficients[i];
   }
-  return false;
-}
-
-}  // namespace
-
-double LinregPredictVector(const std::array<double, feature_count>& features) {
-  // Standardise numeric features
-  std::array<double, standardise_feat_count> numeric_features;
-  std::copy(features.begin(), features.begin() + standardise_feat_count,
-            numeric_features.begin());
-  bool has_outliers = StandardiseFeatsNoOutliers(
-      &numeric_features, standardise_feat_means, standardise_feat_scale);
-  if (has_outliers) {
-    VLOG(2) << "Feature set has outliers, return 0";
-    return 0;
+  // The rest of the features are used as-is
+  for (unsigned int i = standardise_feat_count; i < feature_count; i++) {
+    log_prediction += features[i] * model_coefficients[i];
   }
-
-  // Create a new feature vector to include all features
-  std::array<double, feature_count> standardised_features;
-  std::move(numeric_features.begin(), numeric_features.end(),
-            standardised_features.begin());
-  // Just copy the rest of the features as-is
-  std::copy(features.begin() + standardise_feat_count, features.end(),
-            standardised_features.begin() + standardise_feat_count);
-
-  // Calculate the prediction
-  double log_prediction = std::inner_product(
-      standardised_features.begin(), standardised_features.end(),
-      model_coefficients.begin(), model_intercept);
   // We know the target is log-scaled but care about the absolute value
   return std::pow(10, log_prediction);
 }
@@ -75,4 +47,20 @@ double LinregPredictNamed(const base::flat_map<std::string, double>& features) {
   return LinregPredictVector(feature_vector);
 }
 
+base::Optional<unsigned int> GetThirdPartyFeatureIndex(
+    const std::string& entity) {
+  static const base::NoDestructor<base::flat_map<std::string, unsigned int>>
+      index([] {
+        std::vector<std::pair<std::string, unsigned int>> entries;
+        for (unsigned int i = 0; i < relevant_entities.size(); i++)
+          entries.emplace_back(relevant_entities[i],
+                               third_party_feat_offset + i);
+        return base::flat_map<std::string, unsigned int>(std::move(entries));
+      }());
+  const auto it = index->find(entity);
+  if (it == index->end())
+    return base::nullopt;
+  return it->second;
+}
+
 }  // namespace brave_perf_predictor
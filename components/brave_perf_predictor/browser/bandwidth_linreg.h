@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/optional.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 
 namespace brave_perf_predictor {
@@ -31,6 +32,11 @@ double LinregPredictVector(const std::array<double, feature_count>& features);
 // any extra features.
 double LinregPredictNamed(const base::flat_map<std::string, double>& features);
 
+// Returns the position of the "thirdParties.<entity>.blocked" feature in the
+// feature vector, or nullopt if the model doesn't use the entity.
+base::Optional<unsigned int> GetThirdPartyFeatureIndex(
+    const std::string& entity);
+
 }  // namespace brave_perf_predictor
 
 #endif  // BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_LINREG_H_
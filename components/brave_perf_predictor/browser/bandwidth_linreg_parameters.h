@@ -288,6 +288,39 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 3333644.900695055
 };
 
+// Positions of the standardised features in |feature_sequence|.
+enum FeatureIndex : unsigned int {
+  kFeatureAdblockRequests,
+  kFeatureMetricsFirstMeaningfulPaint,
+  kFeatureMetricsObservedDomContentLoaded,
+  kFeatureMetricsObservedFirstVisualChange,
+  kFeatureMetricsObservedLoad,
+  kFeatureResourcesDocumentRequestCount,
+  kFeatureResourcesDocumentSize,
+  kFeatureResourcesFontRequestCount,
+  kFeatureResourcesFontSize,
+  kFeatureResourcesImageRequestCount,
+  kFeatureResourcesImageSize,
+  kFeatureResourcesMediaRequestCount,
+  kFeatureResourcesMediaSize,
+  kFeatureResourcesOtherRequestCount,
+  kFeatureResourcesOtherSize,
+  kFeatureResourcesScriptRequestCount,
+  kFeatureResourcesScriptSize,
+  kFeatureResourcesStylesheetRequestCount,
+  kFeatureResourcesStylesheetSize,
+  kFeatureResourcesThirdPartyRequestCount,
+  kFeatureResourcesThirdPartySize,
+  kFeatureResourcesTotalRequestCount,
+  kFeatureResourcesTotalSize,
+};
+
+// The "thirdParties.<entity>.blocked" features follow the standardised ones,
+// in the order of |relevant_entities|.
+constexpr unsigned int third_party_feat_offset = standardise_feat_count;
+static_assert(third_party_feat_offset + 190 == feature_count,
+              "Every passthrough feature is a third party");
+
 const std::array<std::string, feature_count> feature_sequence{
     "adblockRequests",
     "metrics.firstMeaningfulPaint",
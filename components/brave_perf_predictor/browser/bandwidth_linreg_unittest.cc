@@ -104,4 +104,25 @@ TEST(BraveSavingsPredictorTest, HandesSpecificFeaturemapExample) {
             794);  // Equal on the order of thousands
 }
 
+TEST(BraveSavingsPredictorTest, FeatureIndexMatchesFeatureSequence) {
+  EXPECT_EQ(feature_sequence[kFeatureAdblockRequests], "adblockRequests");
+  EXPECT_EQ(feature_sequence[kFeatureMetricsObservedLoad],
+            "metrics.observedLoad");
+  EXPECT_EQ(feature_sequence[kFeatureResourcesThirdPartySize],
+            "resources.third-party.size");
+  EXPECT_EQ(feature_sequence[kFeatureResourcesTotalSize],
+            "resources.total.size");
+  EXPECT_EQ(kFeatureResourcesTotalSize + 1, standardise_feat_count);
+}
+
+TEST(BraveSavingsPredictorTest, ThirdPartyFeatureIndex) {
+  for (const auto& entity : relevant_entities) {
+    const auto index = GetThirdPartyFeatureIndex(entity);
+    ASSERT_TRUE(index.has_value()) << entity;
+    EXPECT_EQ(feature_sequence[index.value()],
+              "thirdParties." + entity + ".blocked");
+  }
+  EXPECT_FALSE(GetThirdPartyFeatureIndex("Not A Third Party").has_value());
+}
+
 }  // namespace brave_perf_predictor
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_BANDWIDTH_SAVINGS_PREDICTOR_H_
 
+#include <array>
 #include <string>
 
-#include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
+#include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 #include "url/gurl.h"
 
@@ -64,7 +65,9 @@ class BandwidthSavingsPredictor {
 
   GURL main_frame_url_;
   const NamedThirdPartyRegistry* tp_registry_;  // not owned
-  base::flat_map<std::string, double> feature_map_;
+  // Laid out as the model expects, indexed by |FeatureIndex|.
+  std::array<double, feature_count> features_{};
+  double transfer_total_size_ = 0;
 };
 
 }  // namespace brave_perf_predictor
@@ -0,0 +1,207 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2021 The Brave Authors. All rights reserved.
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this file,
+# You can obtain one at https://mozilla.org/MPL/2.0/.
+
+"""
+Compiles the third-party entities list into the lookup tables used by
+NamedThirdPartyRegistry, so the browser does not parse the JSON at startup.
+
+Only the entities relevant to the bandwidth model are kept. Domains and root
+domains are resolved exactly as NamedThirdPartyRegistry::LoadMappings does.
+
+Usage:
+    generate_named_third_party_table.py --entities entities.json
+        --parameters bandwidth_linreg_parameters.h
+        --public-suffix-list effective_tld_names.dat
+        --output named_third_party_table.inc
+"""
+
+import argparse
+import ipaddress
+import json
+import re
+import sys
+
+
+class PublicSuffixList(object):
+  def __init__(self, path):
+    self.rules = set()
+    self.wildcards = set()
+    self.exceptions = set()
+    with open(path, 'rb') as f:
+      for line in f.read().decode('utf-8').splitlines():
+        fields = line.split()
+        if not fields or fields[0].startswith('//'):
+          continue
+        rule = fields[0]
+        if rule.startswith('!'):
+          self.exceptions.add(self._ToAscii(rule[1:]))
+        elif rule.startswith('*.'):
+          self.wildcards.add(self._ToAscii(rule[2:]))
+        else:
+          self.rules.add(self._ToAscii(rule))
+
+  @staticmethod
+  def _ToAscii(rule):
+    try:
+      return rule.encode('idna').decode('ascii')
+    except UnicodeError:
+      return rule.lower()
+
+  def GetDomainAndRegistry(self, host):
+    """Mirrors net::registry_controlled_domains::GetDomainAndRegistry with
+    INCLUDE_PRIVATE_REGISTRIES."""
+    try:
+      ipaddress.ip_address(host)
+      return ''
+    except ValueError:
+      pass
+
+    labels = host.lower().split('.')
+    # Unknown registries are the last label
+    registry_labels = 1
+    for i in range(len(labels)):
+      suffix = '.'.join(labels[i:])
+      if suffix in self.exceptions:
+        registry_labels = len(labels) - i - 1
+        break
+      if (suffix in self.rules or
+          (i + 1 < len(labels) and '.'.join(labels[i + 1:]) in self.wildcards)):
+        registry_labels = len(labels) - i
+        break
+
+    if registry_labels == 0 or registry_labels >= len(labels):
+      return ''
+    return '.'.join(labels[-(registry_labels + 1):])
+
+
+def ReadRelevantEntities(path):
+  with open(path, 'rb') as f:
+    parameters = f.read().decode('utf-8')
+  block = re.search(r'relevant_entities\{(.*?)\};', parameters, re.DOTALL)
+  if not block:
+    raise Exception('No relevant_entities in ' + path)
+  return set(json.loads('"' + name + '"')
+             for name in re.findall(r'"((?:[^"\\]|\\.)*)"', block.group(1)))
+
+
+def BuildMappings(entities, relevant_entities, public_suffix_list):
+  entity_ids = {}
+  entity_by_domain = {}
+  entity_by_root_domain = {}
+
+  for entity in entities:
+    name = entity.get('name')
+    if not isinstance(name, str) or name not in relevant_entities:
+      continue
+    domains = entity.get('domains')
+    if not isinstance(domains, list):
+      continue
+    entity_id = entity_ids.setdefault(name, len(entity_ids))
+
+    for domain in domains:
+      if not isinstance(domain, str):
+        continue
+      entity_by_domain.setdefault(domain, entity_id)
+      root_domain = public_suffix_list.GetDomainAndRegistry(domain)
+      if entity_by_root_domain.get(root_domain, entity_id) != entity_id:
+        # If there is a clash at root domain level, neither is correct
+        del entity_by_root_domain[root_domain]
+      else:
+        entity_by_root_domain[root_domain] = entity_id
+
+  names = sorted(entity_ids, key=entity_ids.get)
+  return names, entity_by_domain, entity_by_root_domain
+
+
+def EscapeString(value):
+  escaped = ''
+  for byte in bytearray(value.encode('utf-8')):
+    char = chr(byte)
+    if char in '"\\?' or byte < 0x20 or byte > 0x7e:
+      escaped += '\\%03o' % byte
+    else:
+      escaped += char
+  return escaped
+
+
+def WriteTable(output, names, entity_by_domain, entity_by_root_domain):
+  strings = []
+  offsets = {}
+  size = [0]
+
+  def Intern(value):
+    if value not in offsets:
+      offsets[value] = size[0]
+      strings.append(value)
+      size[0] += len(value.encode('utf-8'))
+    return offsets[value]
+
+  def Length(value):
+    length = len(value.encode('utf-8'))
+    if length > 0xffff:
+      raise Exception('String too long: ' + value)
+    return length
+
+  if len(names) > 0xffff:
+    raise Exception('Too many entities')
+
+  name_rows = ['    {%d, %d},' % (Intern(name), Length(name)) for name in names]
+
+  def EntryRows(mappings):
+    # Sorted bytewise, to match base::StringPiece comparison
+    return ['    {%d, %d, %d},' % (Intern(domain), Length(domain), entity)
+            for domain, entity in sorted(
+                mappings.items(), key=lambda item: item[0].encode('utf-8'))]
+
+  domain_rows = EntryRows(entity_by_domain)
+  root_domain_rows = EntryRows(entity_by_root_domain)
+
+  lines = [
+      '// Generated by generate_named_third_party_table.py. Do not edit.',
+      '',
+      'constexpr char kThirdPartyStrings[] =',
+  ]
+  lines += ['    "%s"' % EscapeString(value) for value in strings]
+  lines[-1] += ';'
+  lines += ['', 'constexpr ThirdPartyTableName kThirdPartyEntityNames[] = {']
+  lines += name_rows
+  lines += ['};', '',
+            'constexpr ThirdPartyTableEntry kThirdPartyEntityByDomain[] = {']
+  lines += domain_rows
+  lines += ['};', '',
+            'constexpr ThirdPartyTableEntry kThirdPartyEntityByRootDomain[] = {']
+  lines += root_domain_rows
+  lines += ['};', '']
+
+  with open(output, 'wb') as f:
+    f.write('\n'.join(lines).encode('utf-8'))
+
+
+def main(args):
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--entities', required=True,
+                      help='Path to the third-party entities JSON.')
+  parser.add_argument('--parameters', required=True,
+                      help='Path to bandwidth_linreg_parameters.h.')
+  parser.add_argument('--public-suffix-list', required=True,
+                      help='Path to effective_tld_names.dat.')
+  parser.add_argument('--output', required=True,
+                      help='Path to the generated table.')
+  options = parser.parse_args(args)
+
+  with open(options.entities, 'rb') as f:
+    entities = json.loads(f.read().decode('utf-8'))
+
+  names, entity_by_domain, entity_by_root_domain = BuildMappings(
+      entities, ReadRelevantEntities(options.parameters),
+      PublicSuffixList(options.public_suffix_list))
+  WriteTable(options.output, names, entity_by_domain, entity_by_root_domain)
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main(sys.argv[1:]))
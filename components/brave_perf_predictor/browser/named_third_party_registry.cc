@@ -5,28 +5,31 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
+#include <algorithm>
+#include <map>
 #include <tuple>
+#include <utility>
+#include <vector>
 
-#include "base/bind.h"
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
-#include "base/metrics/histogram_macros.h"
-#include "base/strings/string_piece.h"
+#include "base/stl_util.h"
 #include "base/strings/string_util.h"
-#include "base/task/post_task.h"
-#include "base/task/thread_pool.h"
 #include "base/values.h"
 #include "brave/components/brave_perf_predictor/browser/bandwidth_linreg_parameters.h"
-#include "components/grit/brave_components_resources.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "ui/base/resource/resource_bundle.h"
 #include "url/gurl.h"
 
 namespace brave_perf_predictor {
 
 namespace {
 
+// Defines kThirdPartyStrings, kThirdPartyEntityNames,
+// kThirdPartyEntityByDomain and kThirdPartyEntityByRootDomain.
+#include "brave/components/brave_perf_predictor/browser/named_third_party_table.inc"
+
 std::tuple<base::flat_map<std::string, std::string>,
            base::flat_map<std::string, std::string>>
 ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
@@ -84,44 +87,87 @@ ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
   return std::make_tuple(entity_by_domain, entity_by_root_domain);
 }
 
-std::tuple<base::flat_map<std::string, std::string>,
-           base::flat_map<std::string, std::string>>
-ParseFromResource(int resource_id) {
-  // TODO(AndriusA): insert trace event here
-  SCOPED_UMA_HISTOGRAM_TIMER(
-      "Brave.Savings.NamedThirdPartyRegistry.LoadTimeMS");
-  auto& resource_bundle = ui::ResourceBundle::GetSharedInstance();
-  std::string data_resource =
-      resource_bundle.LoadDataResourceString(resource_id);
-  // Parse resource, discarding irrelevant entities
-  return ParseMappings(data_resource, true);
-}
-
 }  // namespace
 
+struct NamedThirdPartyRegistry::LoadedTables {
+  std::string strings;
+  std::vector<ThirdPartyTableName> entity_names;
+  std::vector<ThirdPartyTableEntry> entity_by_domain;
+  std::vector<ThirdPartyTableEntry> entity_by_root_domain;
+};
+
 bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
                                            bool discard_irrelevant) {
   // Reset previous mappings
-  entity_by_domain_.clear();
-  entity_by_root_domain_.clear();
+  strings_ = base::StringPiece();
+  entity_names_ = {};
+  entity_by_domain_ = {};
+  entity_by_root_domain_ = {};
+  loaded_tables_.reset();
   initialized_ = false;
 
-  tie(entity_by_domain_, entity_by_root_domain_) =
+  base::flat_map<std::string, std::string> entity_by_domain;
+  base::flat_map<std::string, std::string> entity_by_root_domain;
+  tie(entity_by_domain, entity_by_root_domain) =
       ParseMappings(entities, discard_irrelevant);
-  if (entity_by_domain_.size() == 0 || entity_by_root_domain_.size() == 0)
+  if (entity_by_domain.size() == 0 || entity_by_root_domain.size() == 0)
     return false;
 
+  // Lay the mappings out like the compiled tables, so both share one lookup
+  auto tables = std::make_unique<LoadedTables>();
+  std::map<std::string, uint16_t> entity_ids;
+  auto add_string = [&tables](const std::string& value) {
+    const uint32_t offset = static_cast<uint32_t>(tables->strings.size());
+    tables->strings.append(value);
+    return offset;
+  };
+  auto add_entries =
+      [&](const base::flat_map<std::string, std::string>& mappings,
+          std::vector<ThirdPartyTableEntry>* table) {
+        for (const auto& mapping : mappings) {
+          const auto inserted = entity_ids.emplace(
+              mapping.second,
+              static_cast<uint16_t>(tables->entity_names.size()));
+          if (inserted.second) {
+            tables->entity_names.push_back(
+                {add_string(mapping.second),
+                 static_cast<uint16_t>(mapping.second.size())});
+          }
+          table->push_back({add_string(mapping.first),
+                            static_cast<uint16_t>(mapping.first.size()),
+                            inserted.first->second});
+        }
+      };
+  add_entries(entity_by_domain, &tables->entity_by_domain);
+  add_entries(entity_by_root_domain, &tables->entity_by_root_domain);
+
+  strings_ = tables->strings;
+  entity_names_ = tables->entity_names;
+  entity_by_domain_ = tables->entity_by_domain;
+  entity_by_root_domain_ = tables->entity_by_root_domain;
+  loaded_tables_ = std::move(tables);
   initialized_ = true;
   return true;
 }
 
-void NamedThirdPartyRegistry::UpdateMappings(
-    std::tuple<base::flat_map<std::string, std::string>,
-               base::flat_map<std::string, std::string>> entity_mappings) {
-  tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
-  VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
-          << entity_by_root_domain_.size() << " by root domain; size";
-  initialized_ = true;
+base::StringPiece NamedThirdPartyRegistry::GetString(uint32_t offset,
+                                                     uint16_t length) const {
+  return strings_.substr(offset, length);
+}
+
+base::Optional<std::string> NamedThirdPartyRegistry::FindEntity(
+    base::span<const ThirdPartyTableEntry> table,
+    base::StringPiece domain) const {
+  const auto it = std::lower_bound(
+      table.begin(), table.end(), domain,
+      [this](const ThirdPartyTableEntry& entry, base::StringPiece value) {
+        return GetString(entry.offset, entry.length) < value;
+      });
+  if (it == table.end() || GetString(it->offset, it->length) != domain)
+    return base::nullopt;
+
+  const ThirdPartyTableName& name = entity_names_[it->entity];
+  return GetString(name.offset, name.length).as_string();
 }
 
 base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
@@ -136,16 +182,16 @@ base::Optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
     return base::nullopt;
 
   if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+    auto entity = FindEntity(entity_by_domain_, url.host_piece());
+    if (entity)
+      return entity;
 
     auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
         url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
-    auto root_domain_entry = entity_by_root_domain_.find(root_domain);
-    if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
+    entity = FindEntity(entity_by_root_domain_, root_domain);
+    if (entity)
+      return entity;
   }
 
   return base::nullopt;
@@ -156,11 +202,13 @@ NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
 NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
 
 void NamedThirdPartyRegistry::InitializeDefault() {
-  base::PostTaskAndReplyWithResult(
-      FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&ParseFromResource, IDR_THIRD_PARTY_ENTITIES),
-      base::BindOnce(&NamedThirdPartyRegistry::UpdateMappings,
-                     weak_factory_.GetWeakPtr()));
+  loaded_tables_.reset();
+  strings_ = base::StringPiece(kThirdPartyStrings,
+                               base::size(kThirdPartyStrings) - 1);
+  entity_names_ = kThirdPartyEntityNames;
+  entity_by_domain_ = kThirdPartyEntityByDomain;
+  entity_by_root_domain_ = kThirdPartyEntityByRootDomain;
+  initialized_ = true;
 }
 
 }  // namespace brave_perf_predictor
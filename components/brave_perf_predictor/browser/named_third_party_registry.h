@@ -6,16 +6,30 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 #define BRAVE_COMPONENTS_BRAVE_PERF_PREDICTOR_BROWSER_NAMED_THIRD_PARTY_REGISTRY_H_
 
+#include <stdint.h>
+
+#include <memory>
 #include <string>
-#include <tuple>
 
-#include "base/containers/flat_map.h"
-#include "base/memory/weak_ptr.h"
-#include "base/values.h"
+#include "base/containers/span.h"
+#include "base/optional.h"
+#include "base/strings/string_piece.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace brave_perf_predictor {
 
+// Rows of the lookup tables. Strings are slices of one shared string pool.
+struct ThirdPartyTableName {
+  uint32_t offset;
+  uint16_t length;
+};
+
+struct ThirdPartyTableEntry {
+  uint32_t offset;
+  uint16_t length;
+  uint16_t entity;
+};
+
 // Retrieves publicly known Third Party (organisation) for a given URL, using
 // data from the Third Party Web repository
 // (https://github.com/patrickhulce/third-party-web).
@@ -31,23 +45,30 @@ class NamedThirdPartyRegistry : public KeyedService {
   // entities not relevant to the bandwith prediction model (i.e. those not
   // seen in training the model).
   bool LoadMappings(const base::StringPiece entities, bool discard_irrelevant);
-  // Default initialization - asynchronously load from bundled resource
+  // Default initialization - use the tables compiled from the bundled list by
+  // generate_named_third_party_table.py, which needs no parsing.
   void InitializeDefault();
   base::Optional<std::string> GetThirdParty(
       const base::StringPiece domain) const;
 
  private:
+  struct LoadedTables;
+
   bool IsInitialized() const { return initialized_; }
   void MarkInitialized(bool initialized) { initialized_ = initialized; }
-  void UpdateMappings(
-      std::tuple<base::flat_map<std::string, std::string>,
-                 base::flat_map<std::string, std::string>> entity_mappings);
+  base::StringPiece GetString(uint32_t offset, uint16_t length) const;
+  base::Optional<std::string> FindEntity(
+      base::span<const ThirdPartyTableEntry> table,
+      base::StringPiece domain) const;
 
   bool initialized_ = false;
-  base::flat_map<std::string, std::string> entity_by_domain_;
-  base::flat_map<std::string, std::string> entity_by_root_domain_;
-
-  base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
+  base::StringPiece strings_;
+  base::span<const ThirdPartyTableName> entity_names_;
+  // Both sorted by domain
+  base::span<const ThirdPartyTableEntry> entity_by_domain_;
+  base::span<const ThirdPartyTableEntry> entity_by_root_domain_;
+  // Backs the tables above when they were built by LoadMappings()
+  std::unique_ptr<LoadedTables> loaded_tables_;
 };
 
 }  // namespace brave_perf_predictor
@@ -5,9 +5,13 @@
 
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
+#include <string>
+
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_reader.h"
 #include "base/path_service.h"
+#include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_perf_predictor {
@@ -119,4 +123,43 @@ TEST(NamedThirdPartyRegistryTest, HandlesUnrecognisedThirdPartyTest) {
   EXPECT_FALSE(entity.has_value());
 }
 
+TEST(NamedThirdPartyRegistryTest, DefaultTablesMatchJSON) {
+  const std::string dataset = LoadFile();
+  NamedThirdPartyRegistry parsed;
+  ASSERT_TRUE(parsed.LoadMappings(dataset, true));
+  NamedThirdPartyRegistry compiled;
+  compiled.InitializeDefault();
+
+  base::Optional<base::Value> document = base::JSONReader::Read(dataset);
+  ASSERT_TRUE(document && document->is_list());
+  for (const auto& entity : document->GetList()) {
+    const auto* domains = entity.FindListPath("domains");
+    ASSERT_TRUE(domains);
+    for (const auto& domain : domains->GetList()) {
+      // Subdomains are only found through the root domain table
+      for (const std::string& host :
+           {domain.GetString(), "sub." + domain.GetString()}) {
+        const std::string url = "https://" + host + "/script.js";
+        EXPECT_EQ(parsed.GetThirdParty(url), compiled.GetThirdParty(url))
+            << url;
+      }
+    }
+  }
+
+  for (const char* url : {"http://example.com", "https://8.8.8.8/",
+                          "https://localhost/", "file:///tmp/a.js"}) {
+    EXPECT_EQ(parsed.GetThirdParty(url), compiled.GetThirdParty(url)) << url;
+  }
+}
+
+TEST(NamedThirdPartyRegistryTest, DefaultTablesNeedNoLoading) {
+  NamedThirdPartyRegistry extractor;
+  EXPECT_FALSE(extractor.GetThirdParty("https://google-analytics.com/ga.js"));
+
+  extractor.InitializeDefault();
+  auto entity = extractor.GetThirdParty("https://google-analytics.com/ga.js");
+  ASSERT_TRUE(entity.has_value());
+  EXPECT_EQ(entity.value(), "Google Analytics");
+}
+
 }  // namespace brave_perf_predictor
@@ -11,6 +11,7 @@
 
 class PrefRegistrySimple;
 class PrefService;
+class WeeklyStorage;
 
 namespace base {
 class Clock;
@@ -20,7 +21,9 @@ namespace brave_perf_predictor {
 
 class P3ABandwidthSavingsTracker {
  public:
-  explicit P3ABandwidthSavingsTracker(PrefService* user_prefs);
+  // |weekly_storage| must be the storage of the savings pref and outlive the
+  // tracker.
+  explicit P3ABandwidthSavingsTracker(WeeklyStorage* weekly_storage);
   // Constructor with injected clock for testing
   P3ABandwidthSavingsTracker(PrefService* user_prefs,
                              std::unique_ptr<base::Clock> clock);
@@ -33,8 +36,8 @@ class P3ABandwidthSavingsTracker {
   void RecordSavings(uint64_t savings);
 
  private:
-  PrefService* user_prefs_;
-  std::unique_ptr<base::Clock> clock_;  // Injected clock for testing
+  std::unique_ptr<WeeklyStorage> owned_weekly_storage_;
+  WeeklyStorage* weekly_storage_ = nullptr;
   void StoreSavingsHistogram(uint64_t savings_bytes);
 };
 
@@ -1,4 +1,5 @@
 from config import *
+import re
 import pandas as pd
 import numpy as np
 import joblib
@@ -148,6 +149,15 @@ def train_model(print_params=False, reg=REGRESSOR):
 
     return model.get_params()
 
+def _feature_identifier(feature):
+    """
+    C++ enumerator name for a feature, e.g. resources.third-party.size
+    becomes kFeatureResourcesThirdPartySize
+    """
+    parts = re.split(r'[.\-]', feature)
+    return 'kFeature' + ''.join(part[:1].upper() + part[1:] for part in parts)
+
+
 def export_model():
     # Load trained model and predict on test set
     model = joblib.load(MODEL_PATH)
@@ -184,7 +194,8 @@ def export_model():
             'coefficients': model['model'].coef_
         },
         'misc': {
-            'entities': [ feature.replace('thirdParties.', '').replace('.blocked', '') for feature in transformers['passthrough']['features'] if feature.startswith('thirdParties.') ]
+            'entities': [ feature.replace('thirdParties.', '').replace('.blocked', '') for feature in transformers['passthrough']['features'] if feature.startswith('thirdParties.') ],
+            'feature_identifiers': [ _feature_identifier(feature) for feature in transformers['standardise']['features'] ]
         }
     }
     env.get_template(EXPORT_TEMPLATE_NAME).stream(data).dump(EXPORT_OUTPUT_PATH)
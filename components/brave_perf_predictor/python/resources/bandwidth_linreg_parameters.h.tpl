@@ -32,6 +32,19 @@ constexpr std::array<double, standardise_feat_count> standardise_feat_scale = {
 {{transformers.standardise.scale | join(',\n')}}
 };
 
+// Positions of the standardised features in |feature_sequence|.
+enum FeatureIndex : unsigned int {
+  {% for identifier in misc.feature_identifiers %}
+  {{identifier}},
+  {% endfor %}
+};
+
+// The "thirdParties.<entity>.blocked" features follow the standardised ones,
+// in the order of |relevant_entities|.
+constexpr unsigned int third_party_feat_offset = standardise_feat_count;
+static_assert(third_party_feat_offset + {{misc.entities | length}} == feature_count,
+              "Every passthrough feature is a third party");
+
 const std::array<std::string, feature_count> feature_sequence{
     {% for feature in transformers.standardise.features %}
     "{{feature}}",
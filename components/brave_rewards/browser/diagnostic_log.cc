@@ -8,7 +8,6 @@
 #include <memory>
 #include <utility>
 
-#include "base/files/file_util.h"
 #include "base/i18n/time_formatting.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -17,7 +16,6 @@
 
 namespace {
 
-const int64_t kChunkSize = 1024;
 const size_t kDividerLength = 80;
 
 std::string FormatTime(const base::Time& time) {
@@ -48,235 +46,29 @@ std::string GetLogVerboseLevelName(int verbose_level) {
   return verbose_level_name;
 }
 
-bool Create(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  file->Initialize(file_path, base::File::FLAG_CREATE_ALWAYS |
-                                  base::File::FLAG_READ |
-                                  base::File::FLAG_WRITE);
-
-  return file->IsValid();
-}
-
-bool Open(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  file->Initialize(file_path, base::File::FLAG_OPEN | base::File::FLAG_READ |
-                                  base::File::FLAG_WRITE);
-
-  return file->IsValid();
+std::string ReadLastNLinesOnFileTaskRunner(
+    brave_rewards::DiagnosticLogFile* log_file,
+    int num_lines) {
+  DCHECK(log_file);
+  return log_file->ReadLastNLines(num_lines);
 }
 
-bool CreateOrOpen(const base::FilePath& file_path, base::File* file) {
-  DCHECK(file);
-
-  if (!base::PathExists(file_path)) {
-    return Create(file_path, file);
-  }
-
-  if (!Open(file_path, file)) {
-    return false;
-  }
-
-  return file->IsValid();
-}
-
-int64_t SeekFromEnd(base::File* file, int num_lines) {
-  DCHECK(file);
-
-  if (!file->IsValid()) {
-    return 0;
-  }
-
-  if (num_lines == 0) {
-    return 0;
-  }
-
-  int64_t length = file->GetLength();
-  if (length == -1) {
-    return -1;
-  }
-
-  if (length == 0) {
-    return 0;
-  }
-
-  int line_count = 0;
-
-  char chunk[kChunkSize];
-  int64_t chunk_size = kChunkSize;
-  int64_t last_chunk_size = 0;
-
-  if (file->Seek(base::File::FROM_END, 0) == -1) {
-    return -1;
-  }
-
-  do {
-    if (chunk_size > length) {
-      chunk_size = length;
-    }
-
-    const int64_t seek_offset = chunk_size + last_chunk_size;
-    if (file->Seek(base::File::FROM_CURRENT, -seek_offset) == -1) {
-      return -1;
-    }
-
-    if (file->ReadAtCurrentPos(chunk, chunk_size) == -1) {
-      return -1;
-    }
-
-    for (int i = chunk_size - 1; i >= 0; i--) {
-      if (chunk[i] == '\n') {
-        line_count++;
-        if (line_count == num_lines + 1) {
-          return length;
-        }
-      }
-
-      length--;
-    }
-
-    last_chunk_size = chunk_size;
-  } while (length > 0);
-
-  return length;
-}
-
-bool TrimBeginningOfFile(base::File* file, int keep_num_lines) {
-  DCHECK(file);
-
-  if (file->GetLength() == 0) {
-    return true;
-  }
-
-  const int64_t offset = SeekFromEnd(file, keep_num_lines);
-  if (offset == -1) {
-    return false;
-  }
-
-  if (offset == 0) {
-    return true;
-  }
-
-  if (file->Seek(base::File::FROM_BEGIN, offset) == -1) {
-    return false;
-  }
-
-  const int64_t size = file->GetLength() - offset;
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
-
-  if (file->ReadAtCurrentPos(buffer.get(), size) == -1) {
-    return false;
-  }
-
-  if (file->Seek(base::File::FROM_BEGIN, 0) == -1) {
-    return false;
-  }
-
-  const std::string data = std::string(buffer.get());
-  const int64_t new_size = data.size();
-
-  if (file->WriteAtCurrentPos(data.c_str(), new_size) == -1) {
-    return false;
-  }
-
-  if (!file->SetLength(new_size)) {
-    return false;
-  }
-
-  return true;
-}
-
-bool MaybeTrimBeginningOfFile(base::File* file,
-                              int64_t max_file_size,
-                              int keep_num_lines,
-                              bool first_write) {
-  DCHECK(file);
-
-  const int64_t length = file->GetLength();
-  if (length == -1) {
-    return false;
-  }
-
-  // We do not trim the log on first run so that if the browser
-  // crashes and we investigate the log with the user they are able to
-  // re-run the browser without losing past logs.
-  if (!first_write && length <= max_file_size) {
-    return true;
-  }
-
-  if (!TrimBeginningOfFile(file, keep_num_lines)) {
-    return false;
-  }
-
-  return true;
-}
-
-std::string ReadLastNLinesOnFileTaskRunner(const base::FilePath& file_path,
-                                           int num_lines) {
-  base::File file;
-  if (!Open(file_path, &file)) {
-    return "";
-  }
-
-  if (file.GetLength() == 0) {
-    return "";
-  }
-
-  int64_t offset;
-
-  if (num_lines == -1) {
-    offset = 0;
-  } else {
-    offset = SeekFromEnd(&file, num_lines);
-    if (offset == -1) {
-      return "";
-    }
-  }
-
-  if (file.Seek(base::File::FROM_BEGIN, offset) == -1) {
-    return "";
-  }
-
-  const int64_t size = file.GetLength() - offset;
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
-
-  if (file.ReadAtCurrentPos(buffer.get(), size) == -1) {
-    return "";
-  }
-
-  return std::string(buffer.get());
-}
-
-bool WriteOnFileTaskRunner(const base::FilePath& file_path,
+bool WriteOnFileTaskRunner(brave_rewards::DiagnosticLogFile* log_file,
                            const std::string& log_entry,
-                           int64_t max_file_size,
-                           int keep_num_lines,
                            bool first_write) {
-  base::File file;
-  if (!CreateOrOpen(file_path, &file)) {
-    return false;
-  }
-
-  if (file.Seek(base::File::FROM_END, 0) == -1) {
-    return false;
-  }
+  DCHECK(log_file);
 
   if (first_write) {
     const std::string divider = std::string(kDividerLength, '-') + "\n";
-    file.WriteAtCurrentPos(divider.c_str(), divider.length());
+    log_file->Append(divider);
   }
 
-  if (file.WriteAtCurrentPos(log_entry.c_str(), log_entry.length()) == -1) {
-    return false;
-  }
-
-  return MaybeTrimBeginningOfFile(&file, max_file_size, keep_num_lines,
-                                  first_write);
+  return log_file->Append(log_entry);
 }
 
-bool DeleteOnFileTaskRunner(const base::FilePath& file_path) {
-  return base::DeleteFile(file_path);
+bool DeleteOnFileTaskRunner(brave_rewards::DiagnosticLogFile* log_file) {
+  DCHECK(log_file);
+  return log_file->Delete();
 }
 
 }  // namespace
@@ -290,20 +82,22 @@ DiagnosticLog::DiagnosticLog(const base::FilePath& file_path,
           {base::ThreadPool(), base::MayBlock(),
            base::TaskPriority::USER_VISIBLE,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
-      file_path_(file_path),
-      max_file_size_(max_file_size),
-      keep_num_lines_(keep_num_lines),
+      log_file_(std::make_unique<DiagnosticLogFile>(file_path,
+                                                    max_file_size,
+                                                    keep_num_lines)),
       first_write_(true) {}
 
 DiagnosticLog::~DiagnosticLog() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  file_task_runner_->DeleteSoon(FROM_HERE, log_file_.release());
 }
 
 void DiagnosticLog::ReadLastNLines(int num_lines, ReadCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
-      base::BindOnce(&ReadLastNLinesOnFileTaskRunner, file_path_, num_lines),
+      base::BindOnce(&ReadLastNLinesOnFileTaskRunner,
+                     base::Unretained(log_file_.get()), num_lines),
       base::BindOnce(&DiagnosticLog::OnReadLastNLines, AsWeakPtr(),
                      std::move(callback)));
 }
@@ -313,8 +107,8 @@ void DiagnosticLog::Write(const std::string& log_entry,
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
-      base::BindOnce(&WriteOnFileTaskRunner, file_path_, log_entry,
-                     max_file_size_, keep_num_lines_, first_write_),
+      base::BindOnce(&WriteOnFileTaskRunner, base::Unretained(log_file_.get()),
+                     log_entry, first_write_),
       base::BindOnce(&DiagnosticLog::OnWrite, AsWeakPtr(),
                      std::move(callback)));
   first_write_ = false;
@@ -344,7 +138,9 @@ void DiagnosticLog::Write(const std::string& log_entry,
 void DiagnosticLog::Delete(StatusCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   file_task_runner_->PostTaskAndReplyWithResult(
-      FROM_HERE, base::BindOnce(&DeleteOnFileTaskRunner, file_path_),
+      FROM_HERE,
+      base::BindOnce(&DeleteOnFileTaskRunner,
+                     base::Unretained(log_file_.get())),
       base::BindOnce(&DiagnosticLog::OnDelete, AsWeakPtr(),
                      std::move(callback)));
 }
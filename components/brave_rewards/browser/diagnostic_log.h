@@ -6,18 +6,19 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_H_
 #define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_H_
 
+#include <memory>
 #include <string>
 
-#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/sequence_checker.h"
 #include "base/sequenced_task_runner.h"
+#include "brave/components/brave_rewards/browser/diagnostic_log_file.h"
 
 namespace brave_rewards {
 
-// This class provides access to a diagnostic log file. If the file
-// size ever exceeds the provided maximum file size, it is trimmed to
-// keep only the last n lines.
+// This class provides access to a diagnostic log file. The log is kept in
+// rotating segments by DiagnosticLogFile on a file task runner, so appends
+// never rewrite existing data and old lines are dropped a segment at a time.
 class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
  public:
   DiagnosticLog(const base::FilePath& path,
@@ -35,8 +36,8 @@ class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
   void ReadLastNLines(int num_lines, ReadCallback callback);
 
   // Appends |log_entry| to end of file. If file doesn't exist, it is
-  // created. If total file size exceeds |max_file_size|, removes all
-  // but the last |keep_num_lines| lines.
+  // created. Once the current segment holds |keep_num_lines| lines or half of
+  // |max_file_size| bytes, it replaces the previous segment.
   void Write(const std::string& log_entry, StatusCallback callback);
   void Write(const std::string& log_entry,
              const base::Time& time,
@@ -45,7 +46,7 @@ class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
              int verbose_level,
              StatusCallback callback);
 
-  // Deletes the file.
+  // Deletes the file and its previous segment.
   void Delete(StatusCallback callback);
 
  private:
@@ -54,9 +55,7 @@ class DiagnosticLog : public base::SupportsWeakPtr<DiagnosticLog> {
   void OnDelete(StatusCallback callback, bool result);
 
   scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
-  base::FilePath file_path_;
-  int64_t max_file_size_;
-  int keep_num_lines_;
+  std::unique_ptr<DiagnosticLogFile> log_file_;
   bool first_write_;
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -0,0 +1,260 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/diagnostic_log_file.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/files/file_util.h"
+
+namespace brave_rewards {
+
+namespace {
+
+const int kChunkSize = 64 * 1024;
+const base::FilePath::CharType kPreviousSegmentExtension[] =
+    FILE_PATH_LITERAL(".1");
+
+}  // namespace
+
+DiagnosticLogFile::Segment::Segment() = default;
+
+DiagnosticLogFile::Segment::Segment(Segment&& other) = default;
+
+DiagnosticLogFile::Segment& DiagnosticLogFile::Segment::operator=(
+    Segment&& other) = default;
+
+DiagnosticLogFile::Segment::~Segment() = default;
+
+void DiagnosticLogFile::Segment::Reset() {
+  size = 0;
+  line_offsets.clear();
+  at_line_start = true;
+}
+
+void DiagnosticLogFile::Segment::IndexLines(const char* data,
+                                            int64_t length) {
+  for (int64_t i = 0; i < length; i++) {
+    if (at_line_start) {
+      line_offsets.push_back(size + i);
+      at_line_start = false;
+    }
+
+    if (data[i] == '\n') {
+      at_line_start = true;
+    }
+  }
+
+  size += length;
+}
+
+DiagnosticLogFile::DiagnosticLogFile(const base::FilePath& path,
+                                     int64_t max_file_size,
+                                     int keep_num_lines)
+    : path_(path),
+      previous_path_(path.AddExtension(kPreviousSegmentExtension)),
+      max_segment_size_(max_file_size / 2),
+      max_segment_lines_(keep_num_lines) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+DiagnosticLogFile::~DiagnosticLogFile() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+bool DiagnosticLogFile::Append(const std::string& data) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!Initialize()) {
+    return false;
+  }
+
+  if (ShouldRotate() && !Rotate()) {
+    return false;
+  }
+
+  const int size = static_cast<int>(data.length());
+  if (file_.Write(current_.size, data.c_str(), size) != size) {
+    return false;
+  }
+
+  current_.IndexLines(data.c_str(), size);
+
+  return true;
+}
+
+std::string DiagnosticLogFile::ReadLastNLines(int num_lines) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!Initialize()) {
+    return "";
+  }
+
+  const size_t current_lines = current_.line_offsets.size();
+  const size_t previous_lines = previous_.line_offsets.size();
+
+  std::string data;
+
+  if (num_lines != -1 && static_cast<size_t>(num_lines) <= current_lines) {
+    if (num_lines == 0) {
+      return "";
+    }
+
+    const int64_t offset = current_.line_offsets[current_lines - num_lines];
+    if (!ReadSegment(path_, current_, offset, &data)) {
+      return "";
+    }
+
+    return data;
+  }
+
+  int64_t previous_offset = 0;
+  if (num_lines != -1) {
+    const size_t lines = num_lines - current_lines;
+    if (lines < previous_lines) {
+      previous_offset = previous_.line_offsets[previous_lines - lines];
+    }
+  }
+
+  if (!ReadSegment(previous_path_, previous_, previous_offset, &data)) {
+    return "";
+  }
+
+  std::string current_data;
+  if (!ReadSegment(path_, current_, 0, &current_data)) {
+    return "";
+  }
+
+  return data + current_data;
+}
+
+bool DiagnosticLogFile::Delete() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  file_.Close();
+  current_.Reset();
+  previous_.Reset();
+  is_initialized_ = false;
+
+  const bool deleted_previous = base::DeleteFile(previous_path_);
+  const bool deleted_current = base::DeleteFile(path_);
+
+  return deleted_previous && deleted_current;
+}
+
+bool DiagnosticLogFile::Initialize() {
+  if (is_initialized_) {
+    return true;
+  }
+
+  current_.Reset();
+  previous_.Reset();
+
+  if (!IndexSegment(previous_path_, &previous_)) {
+    return false;
+  }
+
+  if (!IndexSegment(path_, &current_)) {
+    return false;
+  }
+
+  file_.Initialize(path_, base::File::FLAG_OPEN_ALWAYS |
+                              base::File::FLAG_READ |
+                              base::File::FLAG_WRITE);
+  if (!file_.IsValid()) {
+    return false;
+  }
+
+  is_initialized_ = true;
+
+  return true;
+}
+
+bool DiagnosticLogFile::IndexSegment(const base::FilePath& path,
+                                     Segment* segment) {
+  DCHECK(segment);
+
+  if (!base::PathExists(path)) {
+    return true;
+  }
+
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
+    return false;
+  }
+
+  std::unique_ptr<char[]> chunk = std::make_unique<char[]>(kChunkSize);
+  while (true) {
+    const int read = file.ReadAtCurrentPos(chunk.get(), kChunkSize);
+    if (read == -1) {
+      return false;
+    }
+
+    if (read == 0) {
+      break;
+    }
+
+    segment->IndexLines(chunk.get(), read);
+  }
+
+  return true;
+}
+
+bool DiagnosticLogFile::ShouldRotate() const {
+  return current_.size >= max_segment_size_ ||
+         current_.line_offsets.size() >= max_segment_lines_;
+}
+
+bool DiagnosticLogFile::Rotate() {
+  file_.Close();
+
+  if (!base::ReplaceFile(path_, previous_path_, nullptr)) {
+    is_initialized_ = false;
+    return false;
+  }
+
+  previous_ = std::move(current_);
+  current_.Reset();
+
+  file_.Initialize(path_, base::File::FLAG_CREATE_ALWAYS |
+                              base::File::FLAG_READ |
+                              base::File::FLAG_WRITE);
+  if (!file_.IsValid()) {
+    is_initialized_ = false;
+    return false;
+  }
+
+  return true;
+}
+
+bool DiagnosticLogFile::ReadSegment(const base::FilePath& path,
+                                    const Segment& segment,
+                                    int64_t offset,
+                                    std::string* data) {
+  DCHECK(data);
+
+  const int64_t size = segment.size - offset;
+  if (size <= 0) {
+    return true;
+  }
+
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid()) {
+    return false;
+  }
+
+  const size_t data_offset = data->size();
+  data->resize(data_offset + size);
+  if (file.Read(offset, &(*data)[data_offset], static_cast<int>(size)) !=
+      size) {
+    data->resize(data_offset);
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace brave_rewards
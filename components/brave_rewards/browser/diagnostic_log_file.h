@@ -0,0 +1,88 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_FILE_H_
+#define BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_FILE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/sequence_checker.h"
+
+namespace brave_rewards {
+
+// Fixed capacity log stored as two rotating segment files. Entries are
+// appended to the current segment at |path|. Once it holds |keep_num_lines|
+// lines or half of |max_file_size| bytes it is renamed to |path|.1, replacing
+// the previous segment, so existing data is never rewritten and at least the
+// last |keep_num_lines| lines that fit in |max_file_size| are always kept.
+// The start offset of every line is indexed, so reading the last n lines is a
+// single seek into each segment.
+//
+// Performs blocking IO and must be used on a sequence that allows it.
+class DiagnosticLogFile {
+ public:
+  DiagnosticLogFile(const base::FilePath& path,
+                    int64_t max_file_size,
+                    int keep_num_lines);
+  DiagnosticLogFile(const DiagnosticLogFile&) = delete;
+  DiagnosticLogFile& operator=(const DiagnosticLogFile&) = delete;
+  ~DiagnosticLogFile();
+
+  // Appends |data| to the current segment, rotating segments first if the
+  // current segment is full.
+  bool Append(const std::string& data);
+
+  // Reads last |num_lines| lines across both segments. If |num_lines| is -1,
+  // reads everything.
+  std::string ReadLastNLines(int num_lines);
+
+  // Deletes both segments.
+  bool Delete();
+
+ private:
+  struct Segment {
+    Segment();
+    Segment(Segment&& other);
+    Segment& operator=(Segment&& other);
+    ~Segment();
+
+    void Reset();
+    void IndexLines(const char* data, int64_t length);
+
+    int64_t size = 0;
+    std::vector<int64_t> line_offsets;
+    bool at_line_start = true;
+  };
+
+  bool Initialize();
+  bool IndexSegment(const base::FilePath& path, Segment* segment);
+  bool ShouldRotate() const;
+  bool Rotate();
+  bool ReadSegment(const base::FilePath& path,
+                   const Segment& segment,
+                   int64_t offset,
+                   std::string* data);
+
+  const base::FilePath path_;
+  const base::FilePath previous_path_;
+  const int64_t max_segment_size_;
+  const size_t max_segment_lines_;
+
+  bool is_initialized_ = false;
+  base::File file_;
+  Segment current_;
+  Segment previous_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_rewards
+
+#endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_DIAGNOSTIC_LOG_FILE_H_
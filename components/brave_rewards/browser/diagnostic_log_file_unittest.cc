@@ -0,0 +1,87 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_rewards/browser/diagnostic_log_file.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=DiagnosticLogFileTest.*
+
+namespace brave_rewards {
+
+class DiagnosticLogFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("Rewards.log");
+  }
+
+  base::FilePath previous_path() const {
+    return path_.AddExtension(FILE_PATH_LITERAL(".1"));
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(DiagnosticLogFileTest, ReadLastNLines) {
+  DiagnosticLogFile log_file(path_, 1024 * 1024, 100);
+
+  ASSERT_TRUE(log_file.Append("one\n"));
+  ASSERT_TRUE(log_file.Append("two\nthree\n"));
+
+  EXPECT_EQ("three\n", log_file.ReadLastNLines(1));
+  EXPECT_EQ("two\nthree\n", log_file.ReadLastNLines(2));
+  EXPECT_EQ("one\ntwo\nthree\n", log_file.ReadLastNLines(10));
+  EXPECT_EQ("one\ntwo\nthree\n", log_file.ReadLastNLines(-1));
+  EXPECT_EQ("", log_file.ReadLastNLines(0));
+}
+
+TEST_F(DiagnosticLogFileTest, RotatesSegmentsWithoutLosingLastLines) {
+  DiagnosticLogFile log_file(path_, 1024 * 1024, 3);
+
+  for (int i = 0; i < 7; i++) {
+    ASSERT_TRUE(log_file.Append(base::NumberToString(i) + "\n"));
+  }
+
+  EXPECT_TRUE(base::PathExists(previous_path()));
+  EXPECT_EQ("3\n4\n5\n6\n", log_file.ReadLastNLines(-1));
+  EXPECT_EQ("4\n5\n6\n", log_file.ReadLastNLines(3));
+  EXPECT_EQ("5\n6\n", log_file.ReadLastNLines(2));
+}
+
+TEST_F(DiagnosticLogFileTest, IndexesExistingSegments) {
+  {
+    DiagnosticLogFile log_file(path_, 1024 * 1024, 2);
+    for (int i = 0; i < 3; i++) {
+      ASSERT_TRUE(log_file.Append(base::NumberToString(i) + "\n"));
+    }
+  }
+
+  DiagnosticLogFile log_file(path_, 1024 * 1024, 2);
+  ASSERT_TRUE(log_file.Append("3\n"));
+
+  EXPECT_EQ("0\n1\n2\n3\n", log_file.ReadLastNLines(-1));
+  EXPECT_EQ("1\n2\n3\n", log_file.ReadLastNLines(3));
+}
+
+TEST_F(DiagnosticLogFileTest, Delete) {
+  DiagnosticLogFile log_file(path_, 1024 * 1024, 1);
+  ASSERT_TRUE(log_file.Append("one\n"));
+  ASSERT_TRUE(log_file.Append("two\n"));
+
+  EXPECT_TRUE(log_file.Delete());
+
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_FALSE(base::PathExists(previous_path()));
+  EXPECT_EQ("", log_file.ReadLastNLines(-1));
+}
+
+}  // namespace brave_rewards
@@ -47,6 +47,7 @@ void DispatchOnUI(
     const GURL url,
     const GURL first_party_url,
     const std::string referrer,
+    const std::string media_type,
     int render_process_id,
     int render_frame_id,
     int frame_tree_node_id) {
@@ -66,7 +67,7 @@ void DispatchOnUI(
   if (rewards_service)
     rewards_service->OnPostData(tab_helper->session_id(),
                                 url, first_party_url,
-                                GURL(referrer), post_data);
+                                GURL(referrer), post_data, media_type);
 }
 
 }  // namespace
@@ -76,12 +77,15 @@ int OnBeforeURLRequest(
   std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
+  const std::string media_type =
+      GetMediaLinkType(ctx->request_url, ctx->tab_origin, ctx->referrer);
+  if (!media_type.empty()) {
     if (!ctx->upload_data.empty()) {
       DispatchOnUI(ctx->upload_data,
                    ctx->request_url,
                    ctx->tab_url,
                    ctx->referrer.spec(),
+                   media_type,
                    ctx->render_process_id,
                    ctx->render_frame_id,
                    ctx->frame_tree_node_id);
@@ -13,17 +13,13 @@
 #include "brave/components/brave_rewards/browser/rewards_service_observer.h"
 #include "components/prefs/pref_registry_simple.h"
 
-#if !BUILDFLAG(BRAVE_REWARDS_ENABLED)
-#include "content/public/common/referrer.h"
-#endif
-
 namespace brave_rewards {
 
 #if !BUILDFLAG(BRAVE_REWARDS_ENABLED)
-bool IsMediaLink(const GURL& url,
-                 const GURL& first_party_url,
-                 const content::Referrer& referrer) {
-  return false;
+std::string GetMediaLinkType(const GURL& url,
+                             const GURL& first_party_url,
+                             const GURL& referrer) {
+  return "";
 }
 #endif
 
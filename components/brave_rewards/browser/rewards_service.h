@@ -30,9 +30,11 @@ class NavigationHandle;
 
 namespace brave_rewards {
 
-bool IsMediaLink(const GURL& url,
-                 const GURL& first_party_url,
-                 const GURL& referrer);
+// Returns the media type of |url| if its post data should be forwarded to
+// |RewardsService::OnPostData|, otherwise an empty string
+std::string GetMediaLinkType(const GURL& url,
+                             const GURL& first_party_url,
+                             const GURL& referrer);
 
 class RewardsNotificationService;
 class RewardsServiceObserver;
@@ -177,7 +179,8 @@ class RewardsService : public KeyedService {
                           const GURL& url,
                           const GURL& first_party_url,
                           const GURL& referrer,
-                          const std::string& post_data) = 0;
+                          const std::string& post_data,
+                          const std::string& media_type) = 0;
 
   virtual void GetReconcileStamp(
       const GetReconcileStampCallback& callback) = 0;
@@ -278,12 +278,12 @@ std::string GetPrefPath(const std::string& name) {
 
 }  // namespace
 
-bool IsMediaLink(const GURL& url,
-                 const GURL& first_party_url,
-                 const GURL& referrer) {
-  return ledger::Ledger::IsMediaLink(url.spec(),
-                                     first_party_url.spec(),
-                                     referrer.spec());
+std::string GetMediaLinkType(const GURL& url,
+                             const GURL& first_party_url,
+                             const GURL& referrer) {
+  return ledger::Ledger::GetMediaLinkType(url.spec(),
+                                          first_party_url.spec(),
+                                          referrer.spec());
 }
 
 
@@ -702,7 +702,8 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
                                     const GURL& url,
                                     const GURL& first_party_url,
                                     const GURL& referrer,
-                                    const std::string& post_data) {
+                                    const std::string& post_data,
+                                    const std::string& media_type) {
   if (!Connected()) {
     return;
   }
@@ -731,6 +732,7 @@ void RewardsServiceImpl::OnPostData(SessionID tab_id,
                           first_party_url.spec(),
                           referrer.spec(),
                           output,
+                          media_type,
                           std::move(data));
 }
 
@@ -746,6 +748,14 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
     return;
   }
 
+  // Most loads aren't media, so classify them before parsing the query or
+  // sending anything to the ledger
+  const std::string media_type = ledger::Ledger::GetXHRMediaLinkType(
+      url.spec(), first_party_url.spec(), referrer.spec());
+  if (media_type.empty()) {
+    return;
+  }
+
   base::flat_map<std::string, std::string> parts;
 
   for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
@@ -761,6 +771,7 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
                          parts,
                          first_party_url.spec(),
                          referrer.spec(),
+                         media_type,
                          std::move(data));
 }
 
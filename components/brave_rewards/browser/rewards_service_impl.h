@@ -155,7 +155,8 @@ class RewardsServiceImpl : public RewardsService,
                   const GURL& url,
                   const GURL& first_party_url,
                   const GURL& referrer,
-                  const std::string& post_data) override;
+                  const std::string& post_data,
+                  const std::string& media_type) override;
   std::string URIEncode(const std::string& value) override;
   void GetReconcileStamp(const GetReconcileStampCallback& callback) override;
   void GetAutoContributeEnabled(
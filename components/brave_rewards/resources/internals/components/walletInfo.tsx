@@ -20,6 +20,15 @@ const getKeyInfoSeedValidString = (isValid: boolean) => {
   return getLocale('invalid')
 }
 
+const getHitRateString = (hits: number, misses: number) => {
+  const total = hits + misses
+  if (total === 0) {
+    return '-'
+  }
+
+  return `${Math.round(hits * 100 / total)}% (${hits}/${total})`
+}
+
 const getInfo = (state: RewardsInternals.State) => {
   return (
     <>
@@ -32,6 +41,9 @@ const getInfo = (state: RewardsInternals.State) => {
       <div>
         {getLocale('bootStamp')} {formatDate(state.info.bootStamp * 1000)}
       </div>
+      <div>
+        {getLocale('mediaResolverHitRate')} {getHitRateString(state.info.mediaResolverHits, state.info.mediaResolverMisses)}
+      </div>
     </>)
 }
 
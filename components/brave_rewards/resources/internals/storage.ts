@@ -10,7 +10,9 @@ const defaultState: RewardsInternals.State = {
   info: {
     isKeyInfoSeedValid: false,
     walletPaymentId: '',
-    bootStamp: 0
+    bootStamp: 0,
+    mediaResolverHits: 0,
+    mediaResolverMisses: 0
   },
   contributions: [],
   promotions: [],
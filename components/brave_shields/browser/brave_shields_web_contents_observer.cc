@@ -5,12 +5,14 @@
 
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
@@ -53,6 +55,29 @@ using content::WebContents;
 
 namespace {
 
+constexpr base::TimeDelta kFlushBlockedEventsInterval =
+    base::TimeDelta::FromMilliseconds(100);
+
+// Flush early if a page blocks a burst of resources so a batch stays small
+const size_t kMaxPendingBlockedEvents = 500;
+
+bool g_flush_blocked_events_immediately_for_testing = false;
+
+// Returns the pref counting blocks of |block_type| or nullptr if there is none
+const char* GetCounterPrefName(const std::string& block_type) {
+  if (block_type == brave_shields::kAds) {
+    return kAdsBlocked;
+  } else if (block_type == brave_shields::kHTTPUpgradableResources) {
+    return kHttpsUpgrades;
+  } else if (block_type == brave_shields::kJavaScript) {
+    return kJavascriptBlocked;
+  } else if (block_type == brave_shields::kFingerprintingV2) {
+    return kFingerprintingBlocked;
+  }
+
+  return nullptr;
+}
+
 // Content Settings are only sent to the main frame currently.
 // Chrome may fix this at some point, but for now we do this as a work-around.
 // You can verify if this is fixed by running the following test:
@@ -131,6 +156,7 @@ bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
 }
 
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
+  DCHECK(pending_blocked_events_.empty());
 }
 
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
@@ -190,6 +216,10 @@ void BraveShieldsWebContentsObserver::DidFinishNavigation(
   frame_tree_node_id_to_tab_url_[tree_node_id] = web_contents()->GetURL();
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  FlushBlockedEvents();
+}
+
 // static
 GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
     int render_process_id, int render_frame_id, int render_frame_tree_node_id) {
@@ -212,12 +242,81 @@ GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
 
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
     const std::string& subresource) {
-  return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
+  return blocked_url_paths_.find(std::hash<std::string>()(subresource)) !=
+      blocked_url_paths_.end();
 }
 
 void BraveShieldsWebContentsObserver::AddBlockedSubresource(
     const std::string& subresource) {
-  blocked_url_paths_.insert(subresource);
+  blocked_url_paths_.insert(std::hash<std::string>()(subresource));
+}
+
+// static
+void BraveShieldsWebContentsObserver::
+    SetFlushBlockedEventsImmediatelyForTesting(bool immediately) {
+  g_flush_blocked_events_immediately_for_testing = immediately;
+}
+
+// static
+base::TimeDelta
+BraveShieldsWebContentsObserver::GetFlushBlockedEventsIntervalForTesting() {
+  return kFlushBlockedEventsInterval;
+}
+
+// static
+size_t BraveShieldsWebContentsObserver::GetMaxPendingBlockedEventsForTesting() {
+  return kMaxPendingBlockedEvents;
+}
+
+void BraveShieldsWebContentsObserver::AddBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource,
+    bool update_counter) {
+  pending_blocked_events_.push_back({block_type, subresource});
+
+  if (update_counter && !IsBlockedSubresource(subresource)) {
+    AddBlockedSubresource(subresource);
+    const char* pref_name = GetCounterPrefName(block_type);
+    if (pref_name) {
+      pending_counters_[pref_name]++;
+    }
+  }
+
+  if (g_flush_blocked_events_immediately_for_testing ||
+      pending_blocked_events_.size() >= kMaxPendingBlockedEvents) {
+    FlushBlockedEvents();
+    return;
+  }
+
+  if (!flush_blocked_events_timer_.IsRunning()) {
+    flush_blocked_events_timer_.Start(FROM_HERE, kFlushBlockedEventsInterval,
+        base::BindOnce(&BraveShieldsWebContentsObserver::FlushBlockedEvents,
+            base::Unretained(this)));
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushBlockedEvents() {
+  flush_blocked_events_timer_.Stop();
+
+  if (!pending_counters_.empty()) {
+    PrefService* prefs = Profile::FromBrowserContext(
+        web_contents()->GetBrowserContext())->
+        GetOriginalProfile()->
+        GetPrefs();
+    for (const auto& counter : pending_counters_) {
+      prefs->SetUint64(counter.first,
+          prefs->GetUint64(counter.first) + counter.second);
+    }
+    pending_counters_.clear();
+  }
+
+  if (pending_blocked_events_.empty()) {
+    return;
+  }
+
+  std::vector<BlockedEvent> events;
+  events.swap(pending_blocked_events_);
+  DispatchBlockedEventsForWebContents(events, web_contents());
 }
 
 // static
@@ -231,57 +330,48 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
 
   WebContents* web_contents = GetWebContents(render_process_id,
     render_frame_id, frame_tree_node_id);
-  DispatchBlockedEventForWebContents(block_type, subresource, web_contents);
+  if (!web_contents) {
+    return;
+  }
 
-  if (web_contents) {
-    BraveShieldsWebContentsObserver* observer =
-        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
-    if (observer &&
-        !observer->IsBlockedSubresource(subresource)) {
-      observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
-
-      if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
-      } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
-      } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
-      } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
-      }
-    }
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (!observer) {
+    DispatchBlockedEventsForWebContents({{block_type, subresource}},
+        web_contents);
+    return;
   }
+
+  observer->AddBlockedEvent(block_type, subresource, true);
 }
 
 #if !defined(OS_ANDROID)
 // static
-void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
-    const std::string& block_type, const std::string& subresource,
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<BlockedEvent>& events,
     WebContents* web_contents) {
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-  if (!web_contents) {
+  if (!web_contents || events.empty()) {
     return;
   }
   Profile* profile =
       Profile::FromBrowserContext(web_contents->GetBrowserContext());
   EventRouter* event_router = EventRouter::Get(profile);
   if (profile && event_router) {
-    extensions::api::brave_shields::OnBlocked::Details details;
-    details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
-    details.block_type = block_type;
-    details.subresource = subresource;
+    const int tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
+    std::vector<extensions::api::brave_shields::OnResourcesBlocked::
+        DetailsType> details(events.size());
+    for (size_t i = 0; i < events.size(); i++) {
+      details[i].tab_id = tab_id;
+      details[i].block_type = events[i].block_type;
+      details[i].subresource = events[i].subresource;
+    }
     std::unique_ptr<base::ListValue> args(
-        extensions::api::brave_shields::OnBlocked::Create(details)
+        extensions::api::brave_shields::OnResourcesBlocked::Create(details)
           .release());
     std::unique_ptr<Event> event(
         new Event(extensions::events::BRAVE_AD_BLOCKED,
-          extensions::api::brave_shields::OnBlocked::kEventName,
+          extensions::api::brave_shields::OnResourcesBlocked::kEventName,
           std::move(args)));
     event_router->BroadcastEvent(std::move(event));
   }
@@ -306,25 +396,15 @@ bool BraveShieldsWebContentsObserver::OnMessageReceived(
 void BraveShieldsWebContentsObserver::OnJavaScriptBlockedWithDetail(
     RenderFrameHost* render_frame_host,
     const base::string16& details) {
-  WebContents* web_contents =
-      WebContents::FromRenderFrameHost(render_frame_host);
-  if (!web_contents) {
-    return;
-  }
-  DispatchBlockedEventForWebContents(brave_shields::kJavaScript,
-      base::UTF16ToUTF8(details), web_contents);
+  AddBlockedEvent(brave_shields::kJavaScript, base::UTF16ToUTF8(details),
+      false);
 }
 
 void BraveShieldsWebContentsObserver::OnFingerprintingBlockedWithDetail(
     RenderFrameHost* render_frame_host,
     const base::string16& details) {
-  WebContents* web_contents =
-      WebContents::FromRenderFrameHost(render_frame_host);
-  if (!web_contents) {
-    return;
-  }
-  DispatchBlockedEventForWebContents(brave_shields::kFingerprintingV2,
-      base::UTF16ToUTF8(details), web_contents);
+  AddBlockedEvent(brave_shields::kFingerprintingV2,
+      base::UTF16ToUTF8(details), false);
 }
 
 // static
@@ -343,6 +423,9 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
   content::ReloadType reload_type = navigation_handle->GetReloadType();
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument()) {
+    // Blocked events still queued belong to the page being navigated away from
+    FlushBlockedEvents();
+
     if (reload_type == content::ReloadType::NONE) {
       // For new loads, we reset the counters for both blocked scripts and URLs.
       allowed_script_origins_.clear();
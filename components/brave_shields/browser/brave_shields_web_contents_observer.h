@@ -6,14 +6,19 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <map>
-#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -28,13 +33,17 @@ namespace brave_shields {
 class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
     public content::WebContentsUserData<BraveShieldsWebContentsObserver> {
  public:
+  struct BlockedEvent {
+    std::string block_type;
+    std::string subresource;
+  };
+
   explicit BraveShieldsWebContentsObserver(content::WebContents*);
   ~BraveShieldsWebContentsObserver() override;
 
   static void RegisterProfilePrefs(PrefRegistrySimple* registry);
-  static void DispatchBlockedEventForWebContents(
-      const std::string& block_type,
-      const std::string& subresource,
+  static void DispatchBlockedEventsForWebContents(
+      const std::vector<BlockedEvent>& events,
       content::WebContents* web_contents);
   static void DispatchBlockedEvent(
       std::string block_type,
@@ -49,6 +58,12 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
 
+  // Makes blocked events and counters be flushed as soon as they are reported
+  // so tests can check them without waiting for the next batch.
+  static void SetFlushBlockedEventsImmediatelyForTesting(bool immediately);
+  static base::TimeDelta GetFlushBlockedEventsIntervalForTesting();
+  static size_t GetMaxPendingBlockedEventsForTesting();
+
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
   struct RenderFrameIdKey {
@@ -74,6 +89,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::NavigationHandle* navigation_handle) override;
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -94,10 +110,25 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  // Queues a blocked event to be sent with the next batch. Events are flushed
+  // at most every |kFlushBlockedEventsInterval| so that pages blocking
+  // hundreds of resources per second cause one extension event and one pref
+  // update per interval instead of one per resource.
+  void AddBlockedEvent(const std::string& block_type,
+                       const std::string& subresource,
+                       bool update_counter);
+  void FlushBlockedEvents();
+
   std::vector<std::string> allowed_script_origins_;
-  // We keep a set of the current page's blocked URLs in case the page
-  // continually tries to load the same blocked URLs.
-  std::set<std::string> blocked_url_paths_;
+  // We keep a set of hashes of the current page's blocked URLs in case the
+  // page continually tries to load the same blocked URLs. A hash collision
+  // only means a blocked URL is not counted.
+  std::unordered_set<size_t> blocked_url_paths_;
+
+  std::vector<BlockedEvent> pending_blocked_events_;
+  std::map<std::string, uint64_t> pending_counters_;
+  base::OneShotTimer flush_blocked_events_timer_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 
 #include <string>
+#include <vector>
 
 #include "brave/browser/android/brave_shields_content_settings.h"
 #include "chrome/browser/android/tab_android.h"
@@ -16,8 +17,8 @@ using content::WebContents;
 
 namespace brave_shields {
 // static
-void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
-    const std::string& block_type, const std::string& subresource,
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<BlockedEvent>& events,
     WebContents* web_contents) {
   if (!web_contents) {
     return;
@@ -29,8 +30,10 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
   if (tab) {
     tabId = tab->GetAndroidId();
   }
-  chrome::android::BraveShieldsContentSettings::DispatchBlockedEvent(
-      tabId, block_type, subresource);
+  for (const auto& event : events) {
+    chrome::android::BraveShieldsContentSettings::DispatchBlockedEvent(
+        tabId, event.block_type, event.subresource);
+  }
 }
 
 }  // namespace brave_shields
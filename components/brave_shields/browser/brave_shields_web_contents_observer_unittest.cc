@@ -0,0 +1,180 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "brave/common/extensions/api/brave_shields.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/test/web_contents_tester.h"
+#include "extensions/browser/test_event_router.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveShieldsWebContentsObserver*
+
+namespace brave_shields {
+
+namespace {
+
+// Records the number of blocked resources in each broadcast event
+class BlockedEventsObserver
+    : public extensions::TestEventRouter::EventObserver {
+ public:
+  BlockedEventsObserver() = default;
+  ~BlockedEventsObserver() override = default;
+
+  void OnBroadcastEvent(const extensions::Event& event) override {
+    if (event.event_name !=
+        extensions::api::brave_shields::OnResourcesBlocked::kEventName) {
+      return;
+    }
+    ASSERT_EQ(1u, event.event_args->GetList().size());
+    batch_sizes_.push_back(event.event_args->GetList()[0].GetList().size());
+  }
+
+  const std::vector<size_t>& batch_sizes() const { return batch_sizes_; }
+
+ private:
+  std::vector<size_t> batch_sizes_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockedEventsObserver);
+};
+
+}  // namespace
+
+class BraveShieldsWebContentsObserverTest
+    : public ChromeRenderViewHostTestHarness {
+ public:
+  BraveShieldsWebContentsObserverTest()
+      : ChromeRenderViewHostTestHarness(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+    BraveShieldsWebContentsObserver::SetFlushBlockedEventsImmediatelyForTesting(
+        false);
+
+    event_router_ = extensions::CreateAndUseTestEventRouter(profile());
+    event_router_->AddEventObserver(&blocked_events_observer_);
+
+    BraveShieldsWebContentsObserver::CreateForWebContents(web_contents());
+    content::WebContentsTester::For(web_contents())
+        ->NavigateAndCommit(GURL("https://example.com"));
+  }
+
+  void TearDown() override {
+    event_router_->RemoveEventObserver(&blocked_events_observer_);
+    ChromeRenderViewHostTestHarness::TearDown();
+  }
+
+  // Reports a blocked ad the way the network delegate does, one per
+  // resource
+  void DispatchBlockedAds(const size_t count) {
+    content::RenderFrameHost* main_frame = web_contents()->GetMainFrame();
+    for (size_t i = 0; i < count; i++) {
+      BraveShieldsWebContentsObserver::DispatchBlockedEvent(
+          kAds,
+          "https://ads.example.com/" + base::NumberToString(next_resource_++),
+          main_frame->GetProcess()->GetID(), main_frame->GetRoutingID(),
+          main_frame->GetFrameTreeNodeId());
+    }
+  }
+
+  uint64_t GetAdsBlocked() {
+    return profile()->GetPrefs()->GetUint64(kAdsBlocked);
+  }
+
+  const std::vector<size_t>& batch_sizes() const {
+    return blocked_events_observer_.batch_sizes();
+  }
+
+  base::TimeDelta flush_interval() const {
+    return BraveShieldsWebContentsObserver::
+        GetFlushBlockedEventsIntervalForTesting();
+  }
+
+  size_t max_pending() const {
+    return BraveShieldsWebContentsObserver::
+        GetMaxPendingBlockedEventsForTesting();
+  }
+
+ private:
+  extensions::TestEventRouter* event_router_ = nullptr;
+  BlockedEventsObserver blocked_events_observer_;
+  size_t next_resource_ = 0;
+};
+
+TEST_F(BraveShieldsWebContentsObserverTest, FlushesBlockedEventsAfterInterval) {
+  DispatchBlockedAds(3);
+  EXPECT_TRUE(batch_sizes().empty());
+  EXPECT_EQ(0u, GetAdsBlocked());
+
+  task_environment()->FastForwardBy(flush_interval() / 2);
+  DispatchBlockedAds(2);
+  EXPECT_TRUE(batch_sizes().empty());
+
+  // The interval is counted from the first pending event
+  task_environment()->FastForwardBy(flush_interval() / 2);
+  EXPECT_EQ(std::vector<size_t>({5}), batch_sizes());
+  EXPECT_EQ(5u, GetAdsBlocked());
+
+  DispatchBlockedAds(1);
+  task_environment()->FastForwardBy(flush_interval());
+  EXPECT_EQ(std::vector<size_t>({5, 1}), batch_sizes());
+  EXPECT_EQ(6u, GetAdsBlocked());
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, FlushesBlockedEventsAtMaxPending) {
+  DispatchBlockedAds(max_pending() - 1);
+  EXPECT_TRUE(batch_sizes().empty());
+
+  DispatchBlockedAds(1);
+  EXPECT_EQ(std::vector<size_t>({max_pending()}), batch_sizes());
+  EXPECT_EQ(max_pending(), GetAdsBlocked());
+
+  // Events after a forced flush start a new batch on the timer
+  DispatchBlockedAds(10);
+  EXPECT_EQ(1u, batch_sizes().size());
+  task_environment()->FastForwardBy(flush_interval());
+  EXPECT_EQ(std::vector<size_t>({max_pending(), 10}), batch_sizes());
+  EXPECT_EQ(max_pending() + 10, GetAdsBlocked());
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, FlushesBlockedEventsOnNavigation) {
+  DispatchBlockedAds(4);
+  EXPECT_TRUE(batch_sizes().empty());
+
+  content::WebContentsTester::For(web_contents())
+      ->NavigateAndCommit(GURL("https://brave.com"));
+  EXPECT_EQ(std::vector<size_t>({4}), batch_sizes());
+  EXPECT_EQ(4u, GetAdsBlocked());
+
+  // Nothing is left for the timer to send
+  task_environment()->FastForwardBy(flush_interval());
+  EXPECT_EQ(1u, batch_sizes().size());
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest,
+       FlushesBlockedEventsOnWebContentsDestroyed) {
+  DispatchBlockedAds(7);
+  EXPECT_TRUE(batch_sizes().empty());
+
+  DeleteContents();
+  EXPECT_EQ(std::vector<size_t>({7}), batch_sizes());
+  EXPECT_EQ(7u, GetAdsBlocked());
+}
+
+}  // namespace brave_shields
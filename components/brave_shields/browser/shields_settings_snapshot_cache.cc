@@ -0,0 +1,70 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_snapshot_cache.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+
+namespace brave_shields {
+
+namespace {
+
+// A handful of tabs are typically loading at once
+constexpr size_t kMaxSnapshots = 32;
+
+bool IsSnapshotContentSettingsType(ContentSettingsType content_type) {
+  return content_type == ContentSettingsType::BRAVE_SHIELDS ||
+         content_type == ContentSettingsType::BRAVE_ADS ||
+         content_type == ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES ||
+         content_type == ContentSettingsType::BRAVE_REFERRERS;
+}
+
+}  // namespace
+
+ShieldsSettingsSnapshotCache::ShieldsSettingsSnapshotCache(
+    HostContentSettingsMap* host_content_settings_map)
+    : host_content_settings_map_(host_content_settings_map),
+      snapshots_(kMaxSnapshots) {
+  host_content_settings_map_->AddObserver(this);
+}
+
+ShieldsSettingsSnapshotCache::~ShieldsSettingsSnapshotCache() = default;
+
+void ShieldsSettingsSnapshotCache::Shutdown() {
+  host_content_settings_map_->RemoveObserver(this);
+  snapshots_.Clear();
+}
+
+ShieldsSettingsSnapshot ShieldsSettingsSnapshotCache::GetSnapshot(
+    const GURL& tab_origin) {
+  auto it = snapshots_.Get(tab_origin);
+  if (it != snapshots_.end())
+    return it->second;
+
+  auto* map = host_content_settings_map_;
+  ShieldsSettingsSnapshot snapshot;
+  snapshot.shields_enabled = GetBraveShieldsEnabled(map, tab_origin);
+  snapshot.allow_ads = GetAdControlType(map, tab_origin) == ControlType::ALLOW;
+  snapshot.https_everywhere_enabled =
+      GetHTTPSEverywhereEnabled(map, tab_origin);
+  snapshot.allow_referrers = AllowReferrers(map, tab_origin);
+  snapshot.version = version_;
+  snapshots_.Put(tab_origin, snapshot);
+  return snapshot;
+}
+
+void ShieldsSettingsSnapshotCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type) {
+  if (!IsSnapshotContentSettingsType(content_type))
+    return;
+  // Patterns may match any number of origins, so start over
+  version_++;
+  snapshots_.Clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,62 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_CACHE_H_
+
+#include <stdint.h>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+
+// The shields settings that every request made by a page depends on, read
+// for the page's top-frame origin.
+struct ShieldsSettingsSnapshot {
+  bool shields_enabled = true;
+  bool allow_ads = false;
+  bool https_everywhere_enabled = true;
+  bool allow_referrers = false;
+  // Changes whenever any shields setting of the profile changes.
+  uint64_t version = 0;
+};
+
+// Keeps a ShieldsSettingsSnapshot for each recently used top-frame origin, so
+// that the requests of a page share one set of HostContentSettingsMap
+// lookups. All snapshots are dropped when a shields setting changes.
+class ShieldsSettingsSnapshotCache : public KeyedService,
+                                     public content_settings::Observer {
+ public:
+  explicit ShieldsSettingsSnapshotCache(
+      HostContentSettingsMap* host_content_settings_map);
+  ~ShieldsSettingsSnapshotCache() override;
+
+  ShieldsSettingsSnapshot GetSnapshot(const GURL& tab_origin);
+
+  // KeyedService overrides:
+  void Shutdown() override;
+
+ private:
+  // content_settings::Observer overrides:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type) override;
+
+  HostContentSettingsMap* host_content_settings_map_;  // NOT OWNED
+  uint64_t version_ = 0;
+  base::MRUCache<GURL, ShieldsSettingsSnapshot> snapshots_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsSnapshotCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_CACHE_H_
@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_snapshot_cache.h"
+
+#include <memory>
+
+#include "base/macros.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::ControlType;
+using brave_shields::ShieldsSettingsSnapshot;
+using brave_shields::ShieldsSettingsSnapshotCache;
+
+class ShieldsSettingsSnapshotCacheTest : public testing::Test {
+ public:
+  ShieldsSettingsSnapshotCacheTest() = default;
+  ~ShieldsSettingsSnapshotCacheTest() override = default;
+
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+    cache_ = std::make_unique<ShieldsSettingsSnapshotCache>(map());
+  }
+
+  void TearDown() override { cache_->Shutdown(); }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile_.get());
+  }
+
+  ShieldsSettingsSnapshotCache* cache() { return cache_.get(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+  std::unique_ptr<ShieldsSettingsSnapshotCache> cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsSnapshotCacheTest);
+};
+
+TEST_F(ShieldsSettingsSnapshotCacheTest, MatchesShieldsUtil) {
+  const GURL url("https://brave.com");
+  brave_shields::SetAdControlType(map(), ControlType::ALLOW, url);
+  brave_shields::SetHTTPSEverywhereEnabled(map(), false, url);
+
+  ShieldsSettingsSnapshot snapshot = cache()->GetSnapshot(url);
+  EXPECT_EQ(brave_shields::GetBraveShieldsEnabled(map(), url),
+            snapshot.shields_enabled);
+  EXPECT_TRUE(snapshot.allow_ads);
+  EXPECT_FALSE(snapshot.https_everywhere_enabled);
+  EXPECT_EQ(brave_shields::AllowReferrers(map(), url),
+            snapshot.allow_referrers);
+
+  // Non-HTTP(S) origins never have shields
+  EXPECT_FALSE(cache()->GetSnapshot(GURL("chrome://settings")).shields_enabled);
+}
+
+TEST_F(ShieldsSettingsSnapshotCacheTest, ShieldsChangeInvalidates) {
+  const GURL url("https://brave.com");
+  ShieldsSettingsSnapshot snapshot = cache()->GetSnapshot(url);
+  EXPECT_TRUE(snapshot.shields_enabled);
+
+  brave_shields::SetBraveShieldsEnabled(map(), false, url);
+  ShieldsSettingsSnapshot updated_snapshot = cache()->GetSnapshot(url);
+  EXPECT_FALSE(updated_snapshot.shields_enabled);
+  EXPECT_NE(snapshot.version, updated_snapshot.version);
+
+  // Settings that aren't part of the snapshot keep it
+  brave_shields::SetNoScriptControlType(map(), ControlType::BLOCK, url);
+  EXPECT_EQ(updated_snapshot.version, cache()->GetSnapshot(url).version);
+}
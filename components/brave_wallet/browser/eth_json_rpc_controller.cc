@@ -5,15 +5,22 @@
 
 #include "brave/components/brave_wallet/browser/eth_json_rpc_controller.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/environment.h"
+#include "base/json/json_reader.h"
+#include "base/stl_util.h"
+#include "base/strings/string_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_call_data_builder.h"
 #include "brave/components/brave_wallet/browser/eth_requests.h"
 #include "brave/components/brave_wallet/browser/eth_response_parser.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/storage_partition.h"
 #include "net/base/load_flags.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 
@@ -44,6 +51,19 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// Decentralized DNS records change rarely, but a domain without records is
+// looked up again soon in case it was only just registered.
+const int kResolutionCacheTTLMinutes = 5;
+const int kNegativeResolutionCacheTTLSeconds = 30;
+const size_t kMaxResolutionCacheSize = 256;
+
+// Reads issued within this window share one JSON-RPC batch request.
+const int kBatchWindowMs = 20;
+const size_t kMaxBatchSize = 50;
+// Responses to reads at the latest block are reused for about one block time.
+const int kResponseCacheTTLSeconds = 12;
+const size_t kMaxResponseCacheSize = 512;
+
 std::string GetInfuraProjectID() {
   std::string project_id(BRAVE_INFURA_PROJECT_ID);
   std::unique_ptr<base::Environment> env(base::Environment::Create());
@@ -61,6 +81,25 @@ bool GetUseStagingInfuraEndpoint() {
   return env->HasVar("BRAVE_INFURA_STAGING");
 }
 
+// JSON-RPC errors, e.g. rate limits or internal node errors, are sent with
+// a 2xx status and must not be reused.
+bool IsCacheableResponse(const std::string& response) {
+  base::Optional<base::Value> value = base::JSONReader::Read(response);
+  return value && value->is_dict() && value->FindKey("result") &&
+         !value->FindKey("error");
+}
+
+// Decodes the string[] returned by the proxy reader's getMany. An
+// unregistered domain is answered with an empty value for every key.
+bool DecodeUnstoppableDomainsRecords(const std::string& result,
+                                     std::vector<std::string>* records) {
+  // Skip the 0x prefix and the offset of the array.
+  const size_t kArrayStart = 2 + 64;
+  if (result.size() < kArrayStart)
+    return false;
+  return brave_wallet::DecodeStringArray(result.substr(kArrayStart), records);
+}
+
 }  // namespace
 
 namespace brave_wallet {
@@ -76,8 +115,16 @@ EthJsonRpcController::~EthJsonRpcController() {}
 void EthJsonRpcController::Request(const std::string& json_payload,
                                    URLRequestCallback callback,
                                    bool auto_retry_on_network_change) {
+  RequestToURL(network_url_, json_payload, std::move(callback),
+               auto_retry_on_network_change);
+}
+
+void EthJsonRpcController::RequestToURL(const GURL& url,
+                                        const std::string& json_payload,
+                                        URLRequestCallback callback,
+                                        bool auto_retry_on_network_change) {
   auto request = std::make_unique<network::ResourceRequest>();
-  request->url = network_url_;
+  request->url = url;
   request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE;
   request->credentials_mode = network::mojom::CredentialsMode::kOmit;
   request->load_flags |= net::LOAD_DO_NOT_SAVE_COOKIES;
@@ -132,6 +179,124 @@ void EthJsonRpcController::OnURLLoaderComplete(
                           headers);
 }
 
+EthJsonRpcController::BatchedRequest::BatchedRequest() = default;
+EthJsonRpcController::BatchedRequest::BatchedRequest(BatchedRequest&&) =
+    default;
+EthJsonRpcController::BatchedRequest&
+EthJsonRpcController::BatchedRequest::operator=(BatchedRequest&&) = default;
+EthJsonRpcController::BatchedRequest::~BatchedRequest() = default;
+
+void EthJsonRpcController::BatchRequest(const std::string& json_payload,
+                                        URLRequestCallback callback) {
+  const std::string cache_key =
+      base::JoinString({network_url_.spec(), json_payload}, " ");
+
+  auto cached = response_cache_.find(cache_key);
+  if (cached != response_cache_.end()) {
+    if (cached->second.expiration_time > base::TimeTicks::Now()) {
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE, base::BindOnce(std::move(callback), net::HTTP_OK,
+                                    cached->second.response,
+                                    std::map<std::string, std::string>()));
+      return;
+    }
+    response_cache_.erase(cached);
+  }
+
+  // The same read queued twice is only sent once.
+  for (auto& pending : pending_batch_) {
+    if (pending.cache_key == cache_key) {
+      pending.callbacks.push_back(std::move(callback));
+      return;
+    }
+  }
+
+  // A batch goes to a single node, so one queued for another network is sent
+  // before starting a new one.
+  if (!pending_batch_.empty() && pending_batch_url_ != network_url_) {
+    batch_timer_.Stop();
+    SendBatch();
+  }
+  pending_batch_url_ = network_url_;
+
+  BatchedRequest request;
+  request.json_payload = json_payload;
+  request.cache_key = cache_key;
+  request.callbacks.push_back(std::move(callback));
+  pending_batch_.push_back(std::move(request));
+
+  if (pending_batch_.size() >= kMaxBatchSize) {
+    batch_timer_.Stop();
+    SendBatch();
+  } else if (!batch_timer_.IsRunning()) {
+    batch_timer_.Start(FROM_HERE,
+                       base::TimeDelta::FromMilliseconds(kBatchWindowMs),
+                       base::BindOnce(&EthJsonRpcController::SendBatch,
+                                      base::Unretained(this)));
+  }
+}
+
+void EthJsonRpcController::SendBatch() {
+  std::vector<BatchedRequest> batch;
+  batch.swap(pending_batch_);
+  if (batch.empty())
+    return;
+
+  // A lone request is sent as is, there is nothing to batch it with.
+  std::string json_payload;
+  if (batch.size() == 1) {
+    json_payload = batch.front().json_payload;
+  } else {
+    std::vector<std::string> payloads;
+    for (const auto& request : batch)
+      payloads.push_back(request.json_payload);
+    json_payload = GetJsonRpcBatch(payloads);
+  }
+
+  RequestToURL(pending_batch_url_, json_payload,
+               base::BindOnce(&EthJsonRpcController::OnBatchResponse,
+                              base::Unretained(this), std::move(batch)),
+               true);
+}
+
+void EthJsonRpcController::OnBatchResponse(
+    std::vector<BatchedRequest> batch,
+    const int status,
+    const std::string& body,
+    const std::map<std::string, std::string>& headers) {
+  const bool success = status >= 200 && status <= 299;
+  std::vector<std::string> responses(batch.size());
+  if (success) {
+    if (batch.size() == 1)
+      responses.front() = body;
+    else
+      ParseJsonRpcBatchResponse(body, batch.size(), &responses);
+  }
+
+  for (size_t i = 0; i < batch.size(); i++) {
+    if (success && IsCacheableResponse(responses[i]))
+      AddToResponseCache(batch[i].cache_key, responses[i]);
+    for (auto& callback : batch[i].callbacks)
+      std::move(callback).Run(status, responses[i], headers);
+  }
+}
+
+void EthJsonRpcController::AddToResponseCache(const std::string& cache_key,
+                                              const std::string& response) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (response_cache_.size() >= kMaxResponseCacheSize) {
+    base::EraseIf(response_cache_, [now](const auto& entry) {
+      return entry.second.expiration_time <= now;
+    });
+    if (response_cache_.size() >= kMaxResponseCacheSize)
+      response_cache_.clear();
+  }
+
+  response_cache_[cache_key] = {
+      response,
+      now + base::TimeDelta::FromSeconds(kResponseCacheTTLSeconds)};
+}
+
 Network EthJsonRpcController::GetNetwork() const {
   return network_;
 }
@@ -143,6 +308,8 @@ GURL EthJsonRpcController::GetNetworkURL() const {
 void EthJsonRpcController::SetNetwork(Network network) {
   std::string subdomain;
   network_ = network;
+  response_cache_.clear();
+  resolution_cache_.clear();
   switch (network) {
     case Network::kMainnet:
       subdomain = "mainnet";
@@ -177,6 +344,8 @@ void EthJsonRpcController::SetNetwork(Network network) {
 void EthJsonRpcController::SetCustomNetwork(const GURL& network_url) {
   network_ = Network::kCustom;
   network_url_ = network_url;
+  response_cache_.clear();
+  resolution_cache_.clear();
 }
 
 void EthJsonRpcController::GetBalance(
@@ -185,8 +354,8 @@ void EthJsonRpcController::GetBalance(
   auto internal_callback =
       base::BindOnce(&EthJsonRpcController::OnGetBalance,
                      base::Unretained(this), std::move(callback));
-  return Request(eth_getBalance(address, "latest"),
-                 std::move(internal_callback), true);
+  BatchRequest(eth_getBalance(address, "latest"),
+               std::move(internal_callback));
 }
 
 void EthJsonRpcController::OnGetBalance(
@@ -218,8 +387,8 @@ bool EthJsonRpcController::GetERC20TokenBalance(
   if (!erc20::BalanceOf(address, &data)) {
     return false;
   }
-  Request(eth_call("", address, "", "", "", data, ""),
-          std::move(internal_callback), true);
+  BatchRequest(eth_call("", address, "", "", "", data, ""),
+               std::move(internal_callback));
   return true;
 }
 
@@ -245,34 +414,86 @@ bool EthJsonRpcController::UnstoppableDomainsProxyReaderGetMany(
     const std::string& domain,
     const std::vector<std::string>& keys,
     UnstoppableDomainsProxyReaderGetManyCallback callback) {
-  auto internal_callback = base::BindOnce(
-      &EthJsonRpcController::OnUnstoppableDomainsProxyReaderGetMany,
-      base::Unretained(this), std::move(callback));
   std::string data;
   if (!unstoppable_domains::GetMany(keys, domain, &data)) {
     return false;
   }
 
-  Request(eth_call("", contract_address, "", "", "", data, "latest"),
-          std::move(internal_callback), true);
+  // The call data already encodes the domain and keys.
+  const std::string cache_key = base::JoinString(
+      {network_url_.spec(), base::ToLowerASCII(contract_address), data}, " ");
+
+  auto cached = resolution_cache_.find(cache_key);
+  if (cached != resolution_cache_.end()) {
+    if (cached->second.expiration_time > base::TimeTicks::Now()) {
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE,
+          base::BindOnce(std::move(callback), true, cached->second.result));
+      return true;
+    }
+    resolution_cache_.erase(cached);
+  }
+
+  auto& pending = pending_resolutions_[cache_key];
+  pending.push_back(std::move(callback));
+  if (pending.size() > 1)
+    return true;
+
+  auto internal_callback = base::BindOnce(
+      &EthJsonRpcController::OnUnstoppableDomainsProxyReaderGetMany,
+      base::Unretained(this), cache_key);
+  BatchRequest(eth_call("", contract_address, "", "", "", data, "latest"),
+               std::move(internal_callback));
   return true;
 }
 
 void EthJsonRpcController::OnUnstoppableDomainsProxyReaderGetMany(
-    UnstoppableDomainsProxyReaderGetManyCallback callback,
+    const std::string& cache_key,
     const int status,
     const std::string& body,
     const std::map<std::string, std::string>& headers) {
-  if (status < 200 || status > 299) {
-    std::move(callback).Run(false, "");
-    return;
-  }
   std::string result;
-  if (!ParseEthCall(body, &result)) {
-    std::move(callback).Run(false, "");
+  bool success = status >= 200 && status <= 299 && ParseEthCall(body, &result);
+  if (success)
+    AddToResolutionCache(cache_key, result);
+  else
+    result.clear();
+
+  auto pending = pending_resolutions_.find(cache_key);
+  if (pending == pending_resolutions_.end())
     return;
+  std::vector<UnstoppableDomainsProxyReaderGetManyCallback> callbacks =
+      std::move(pending->second);
+  pending_resolutions_.erase(pending);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success, result);
+}
+
+void EthJsonRpcController::AddToResolutionCache(const std::string& cache_key,
+                                                const std::string& result) {
+  // Failed requests and answers that don't decode are not cached, only what
+  // the contract actually returned.
+  std::vector<std::string> records;
+  if (!DecodeUnstoppableDomainsRecords(result, &records))
+    return;
+  const bool has_records =
+      std::any_of(records.begin(), records.end(),
+                  [](const std::string& record) { return !record.empty(); });
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (resolution_cache_.size() >= kMaxResolutionCacheSize) {
+    base::EraseIf(resolution_cache_, [now](const auto& entry) {
+      return entry.second.expiration_time <= now;
+    });
+    if (resolution_cache_.size() >= kMaxResolutionCacheSize)
+      resolution_cache_.clear();
   }
-  std::move(callback).Run(true, result);
+
+  const base::TimeDelta ttl =
+      has_records
+          ? base::TimeDelta::FromMinutes(kResolutionCacheTTLMinutes)
+          : base::TimeDelta::FromSeconds(kNegativeResolutionCacheTTLSeconds);
+  resolution_cache_[cache_key] = {result, now + ttl};
 }
 
 // [static]
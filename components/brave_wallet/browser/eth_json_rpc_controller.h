@@ -13,6 +13,8 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "url/gurl.h"
 
@@ -50,6 +52,8 @@ class EthJsonRpcController {
 
   using UnstoppableDomainsProxyReaderGetManyCallback =
       base::OnceCallback<void(bool status, const std::string& result)>;
+  // Answers are cached per network, contract, domain and keys, domains
+  // without records only briefly and failed requests not at all. Identical lookups in flight share a single eth_call.
   bool UnstoppableDomainsProxyReaderGetMany(
       const std::string& contract_address,
       const std::string& domain,
@@ -68,9 +72,42 @@ class EthJsonRpcController {
  private:
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
+  void RequestToURL(const GURL& url,
+                    const std::string& json_payload,
+                    URLRequestCallback callback,
+                    bool auto_retry_on_network_change);
   void OnURLLoaderComplete(SimpleURLLoaderList::iterator iter,
                            URLRequestCallback callback,
                            const std::unique_ptr<std::string> response_body);
+
+  struct BatchedRequest {
+    BatchedRequest();
+    BatchedRequest(BatchedRequest&&);
+    BatchedRequest& operator=(BatchedRequest&&);
+    ~BatchedRequest();
+
+    std::string json_payload;
+    std::string cache_key;
+    std::vector<URLRequestCallback> callbacks;
+  };
+  // Queues a read-only request which is sent together with the others issued
+  // within a short window as one JSON-RPC batch. Its response is reused for
+  // about one block time.
+  void BatchRequest(const std::string& json_payload,
+                    URLRequestCallback callback);
+  void SendBatch();
+  void OnBatchResponse(std::vector<BatchedRequest> batch,
+                       const int status,
+                       const std::string& body,
+                       const std::map<std::string, std::string>& headers);
+
+  struct CachedResponse {
+    std::string response;
+    base::TimeTicks expiration_time;
+  };
+  void AddToResponseCache(const std::string& cache_key,
+                          const std::string& response);
+
   void OnGetBalance(GetBallanceCallback callback,
                     const int status,
                     const std::string& body,
@@ -82,15 +119,36 @@ class EthJsonRpcController {
       const std::map<std::string, std::string>& headers);
 
   void OnUnstoppableDomainsProxyReaderGetMany(
-      UnstoppableDomainsProxyReaderGetManyCallback callback,
+      const std::string& cache_key,
       const int status,
       const std::string& body,
       const std::map<std::string, std::string>& headers);
 
+  // Only successful contract answers are cached, for a shorter time when the
+  // domain has no records.
+  struct ResolutionCacheEntry {
+    std::string result;
+    base::TimeTicks expiration_time;
+  };
+  void AddToResolutionCache(const std::string& cache_key,
+                            const std::string& result);
+
   content::BrowserContext* context_;
   GURL network_url_;
   SimpleURLLoaderList url_loaders_;
   Network network_;
+
+  std::vector<BatchedRequest> pending_batch_;
+  // The node |pending_batch_| was queued for, its responses are cached under
+  // this url even if the network is changed before they arrive.
+  GURL pending_batch_url_;
+  base::OneShotTimer batch_timer_;
+  std::map<std::string, CachedResponse> response_cache_;
+
+  std::map<std::string, ResolutionCacheEntry> resolution_cache_;
+  std::map<std::string,
+           std::vector<UnstoppableDomainsProxyReaderGetManyCallback>>
+      pending_resolutions_;
 };
 
 }  // namespace brave_wallet
@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 
@@ -390,4 +391,16 @@ std::string eth_getLogs(const std::string& from_block_quantity_tag,
   return GetJSON(dictionary);
 }
 
+std::string GetJsonRpcBatch(const std::vector<std::string>& payloads) {
+  base::Value batch(base::Value::Type::LIST);
+  for (size_t i = 0; i < payloads.size(); i++) {
+    base::Optional<base::Value> request = base::JSONReader::Read(payloads[i]);
+    if (!request || !request->is_dict())
+      return std::string();
+    request->SetKey("id", base::Value(static_cast<int>(i)));
+    batch.Append(std::move(*request));
+  }
+  return GetJSON(batch);
+}
+
 }  // namespace brave_wallet
@@ -7,6 +7,8 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_REQUESTS_H_
 
 #include <string>
+#include <vector>
+
 #include "base/values.h"
 
 namespace brave_wallet {
@@ -184,6 +186,11 @@ std::string eth_getLogs(const std::string& from_block_quantity_tag,
 // condition to be met (“target”).
 std::string eth_getWork();
 
+// Combines JSON-RPC request |payloads| into a single batch request. The id of
+// each request is replaced with its index in |payloads|, so the responses can
+// be matched back. Returns an empty string if a payload isn't a JSON object.
+std::string GetJsonRpcBatch(const std::vector<std::string>& payloads);
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_REQUESTS_H_
@@ -328,4 +328,13 @@ TEST(EthRequestUnitTest, eth_getLogs) {
       R"({"id":1,"jsonrpc":"2.0","method":"eth_getLogs","params":[{"address":"0x8888f1f195afa192cfee860698584c030f4c9db1","blockhash":"0xb903239f8543d04b5dc1ba6579132b143087c68db1b2168786408fcbce568238","fromBlock":"0x1","toBlock":"0x2","topics":["0x000000000000000000000000a94f5374fce5edbc8e2a8697c15331677e6ebf0b",["0x000000000000000000000000a94f5374fce5edbc8e2a8697c15331677e6ebf0b","0x0000000000000000000000000aff3454fce5edbc8cca8697c15331677e6ebccc"]]}]})");  // NOLINT
 }
 
+TEST(EthRequestUnitTest, GetJsonRpcBatch) {
+  const std::string get_balance = eth_getBalance(
+      "0x407d73d8a49eeb85d32cf465507dd71d507100c1", "latest");
+  ASSERT_EQ(
+      GetJsonRpcBatch({eth_blockNumber(), get_balance}),
+      R"([{"id":0,"jsonrpc":"2.0","method":"eth_blockNumber","params":[]},{"id":1,"jsonrpc":"2.0","method":"eth_getBalance","params":["0x407d73d8a49eeb85d32cf465507dd71d507100c1","latest"]}])");  // NOLINT
+  ASSERT_EQ(GetJsonRpcBatch({eth_blockNumber(), "invalid JSON"}), "");
+}
+
 }  // namespace brave_wallet
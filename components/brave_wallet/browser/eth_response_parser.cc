@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/logging.h"
 
 namespace {
@@ -43,4 +44,30 @@ bool ParseEthCall(const std::string& json, std::string* result) {
   return ParseSingleStringResult(json, result);
 }
 
+bool ParseJsonRpcBatchResponse(const std::string& json,
+                               size_t request_count,
+                               std::vector<std::string>* responses) {
+  DCHECK(responses);
+  responses->assign(request_count, std::string());
+
+  base::JSONReader::ValueWithError value_with_error =
+      base::JSONReader::ReadAndReturnValueWithError(
+          json, base::JSONParserOptions::JSON_PARSE_RFC);
+  base::Optional<base::Value>& records_v = value_with_error.value;
+  if (!records_v || !records_v->is_list()) {
+    LOG(ERROR) << "Invalid batch response, JSON is: " << json;
+    return false;
+  }
+
+  for (const base::Value& response : records_v->GetList()) {
+    if (!response.is_dict())
+      continue;
+    base::Optional<int> id = response.FindIntKey("id");
+    if (!id || *id < 0 || static_cast<size_t>(*id) >= request_count)
+      continue;
+    base::JSONWriter::Write(response, &(*responses)[*id]);
+  }
+  return true;
+}
+
 }  // namespace brave_wallet
@@ -7,6 +7,8 @@
 #define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_RESPONSE_PARSER_H_
 
 #include <string>
+#include <vector>
+
 #include "base/values.h"
 
 namespace brave_wallet {
@@ -15,6 +17,13 @@ namespace brave_wallet {
 bool ParseEthGetBalance(const std::string& json, std::string* hex_balance);
 bool ParseEthCall(const std::string& json, std::string* result);
 
+// Splits the response to a batch built by GetJsonRpcBatch into
+// |request_count| responses, ordered by request id. Requests the batch has no
+// answer for are left empty.
+bool ParseJsonRpcBatchResponse(const std::string& json,
+                               size_t request_count,
+                               std::vector<std::string>* responses);
+
 }  // namespace brave_wallet
 
 #endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_ETH_RESPONSE_PARSER_H_
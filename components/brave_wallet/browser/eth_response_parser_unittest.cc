@@ -55,4 +55,32 @@ TEST(EthResponseParserUnitTest, ParseEthCall) {
   ASSERT_EQ(result, "0x0");
 }
 
+TEST(EthResponseParserUnitTest, ParseJsonRpcBatchResponse) {
+  std::string json(
+      R"([
+    {"id": 2, "jsonrpc": "2.0", "result": "0x2"},
+    {"id": 0, "jsonrpc": "2.0", "result": "0x0"},
+    {"id": 7, "jsonrpc": "2.0", "result": "0x7"}
+  ])");
+  std::vector<std::string> responses;
+  ASSERT_TRUE(ParseJsonRpcBatchResponse(json, 3, &responses));
+  ASSERT_EQ(responses.size(), 3u);
+
+  std::string result;
+  ASSERT_TRUE(ParseEthCall(responses[0], &result));
+  ASSERT_EQ(result, "0x0");
+  // No answer for the second request.
+  ASSERT_TRUE(responses[1].empty());
+  ASSERT_TRUE(ParseEthCall(responses[2], &result));
+  ASSERT_EQ(result, "0x2");
+}
+
+TEST(EthResponseParserUnitTest, ParseJsonRpcBatchResponseInvalid) {
+  std::vector<std::string> responses;
+  ASSERT_FALSE(ParseJsonRpcBatchResponse("invalid JSON", 2, &responses));
+  ASSERT_FALSE(ParseJsonRpcBatchResponse(R"({"id": 0, "result": "0x0"})", 2,
+                                         &responses));
+  ASSERT_EQ(responses, std::vector<std::string>(2));
+}
+
 }  // namespace brave_wallet
@@ -5,11 +5,16 @@
 
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/optional.h"
+#include "base/ranges/algorithm.h"
 #include "base/task/post_task.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/pref_names.h"
@@ -89,8 +94,57 @@ class BraveShieldsRuleIterator : public RuleIterator {
 };
 
 
-bool IsActive(const Rule& cookie_rule,
-              const std::vector<Rule>& shield_rules) {
+using RulePatterns = std::pair<ContentSettingsPattern, ContentSettingsPattern>;
+
+// Shield rules indexed by the host of their primary pattern.
+class ShieldRulesIndex {
+ public:
+  // |shield_rules| must outlive the index.
+  explicit ShieldRulesIndex(const std::vector<Rule>& shield_rules)
+      : shield_rules_(shield_rules) {
+    for (size_t i = 0; i < shield_rules_.size(); ++i)
+      rules_by_host_[shield_rules_[i].primary_pattern.GetHost()].push_back(i);
+  }
+
+  // Returns the first shield rule whose primary pattern is identical to or
+  // less specific than |pattern|, or nullptr. Such a pattern can only have
+  // the same host as |pattern|, one of its parent domains or no host at all,
+  // so only those buckets are compared.
+  const Rule* FindRule(const ContentSettingsPattern& pattern) const {
+    base::Optional<size_t> first_match;
+    std::string host = pattern.GetHost();
+    while (true) {
+      auto bucket = rules_by_host_.find(host);
+      if (bucket != rules_by_host_.end()) {
+        for (size_t i : bucket->second) {
+          if (first_match && i > *first_match)
+            break;
+          auto compare = shield_rules_[i].primary_pattern.Compare(pattern);
+          // TODO(bridiver) - verify that SUCCESSOR is correct and not
+          // PREDECESSOR
+          if (compare == ContentSettingsPattern::IDENTITY ||
+              compare == ContentSettingsPattern::SUCCESSOR) {
+            first_match = i;
+            break;
+          }
+        }
+      }
+      if (host.empty())
+        break;
+      size_t dot = host.find('.');
+      host = dot == std::string::npos ? std::string() : host.substr(dot + 1);
+    }
+    return first_match ? &shield_rules_[*first_match] : nullptr;
+  }
+
+ private:
+  const std::vector<Rule>& shield_rules_;
+  std::map<std::string, std::vector<size_t>> rules_by_host_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldRulesIndex);
+};
+
+bool IsActive(const Rule& cookie_rule, const ShieldRulesIndex& shield_rules) {
   // don't include default rules in the iterator
   if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
       (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
@@ -99,20 +153,55 @@ bool IsActive(const Rule& cookie_rule,
     return false;
   }
 
-  bool default_value = true;
-  for (const auto& shield_rule : shield_rules) {
-    auto primary_compare =
-        shield_rule.primary_pattern.Compare(cookie_rule.primary_pattern);
-    // TODO(bridiver) - verify that SUCCESSOR is correct and not PREDECESSOR
-    if (primary_compare == ContentSettingsPattern::IDENTITY ||
-        primary_compare == ContentSettingsPattern::SUCCESSOR) {
-      // TODO(bridiver) - move this logic into shields_util for allow/block
-      return
-          ValueToContentSetting(&shield_rule.value) != CONTENT_SETTING_BLOCK;
-    }
+  const Rule* shield_rule = shield_rules.FindRule(cookie_rule.primary_pattern);
+  if (!shield_rule)
+    return true;
+
+  // TODO(bridiver) - move this logic into shields_util for allow/block
+  return ValueToContentSetting(&shield_rule->value) != CONTENT_SETTING_BLOCK;
+}
+
+// Collects the settings given to each pair of patterns by |rules|.
+std::map<RulePatterns, std::set<ContentSetting>> GetSettingsByPatterns(
+    const std::vector<Rule>& rules) {
+  std::map<RulePatterns, std::set<ContentSetting>> settings;
+  for (const auto& rule : rules) {
+    settings[{rule.primary_pattern, rule.secondary_pattern}].insert(
+        ValueToContentSetting(&rule.value));
   }
+  return settings;
+}
 
-  return default_value;
+// Returns a rule without a value for each pair of patterns whose settings
+// differ between |old_rules| and |new_rules|, including added and removed
+// ones.
+std::vector<Rule> GetChangedRules(const std::vector<Rule>& old_rules,
+                                  const std::vector<Rule>& new_rules) {
+  const auto old_settings = GetSettingsByPatterns(old_rules);
+  const auto new_settings = GetSettingsByPatterns(new_rules);
+
+  std::vector<Rule> changes;
+  auto add_change = [&changes](const RulePatterns& patterns) {
+    changes.emplace_back(patterns.first, patterns.second, base::Value(),
+                         base::Time(), SessionModel::Durable);
+  };
+  // Both maps are sorted, so walk them side by side
+  auto old_it = old_settings.begin();
+  auto new_it = new_settings.begin();
+  while (old_it != old_settings.end() || new_it != new_settings.end()) {
+    if (new_it == new_settings.end() ||
+        (old_it != old_settings.end() && old_it->first < new_it->first)) {
+      add_change((old_it++)->first);
+    } else if (old_it == old_settings.end() || new_it->first < old_it->first) {
+      add_change((new_it++)->first);
+    } else {
+      if (old_it->second != new_it->second)
+        add_change(new_it->first);
+      ++old_it;
+      ++new_it;
+    }
+  }
+  return changes;
 }
 
 }  // namespace
@@ -146,6 +235,7 @@ BravePrefProvider::BravePrefProvider(PrefService* prefs,
 
   MigrateShieldsSettings(off_the_record);
 
+  UpdateGoogleCookieRules();
   OnCookieSettingsChanged(ContentSettingsType::BRAVE_COOKIES);
 
   // Enable change notifications after initial setup to avoid notification spam
@@ -366,16 +456,15 @@ bool BravePrefProvider::SetWebsiteSetting(
     const ContentSettingConstraints& constraints) {
   // handle changes to brave cookie settings from chromium cookie settings UI
   if (content_type == ContentSettingsType::COOKIES) {
-    auto* value = in_value.get();
-    auto match = std::find_if(
-        brave_cookie_rules_[off_the_record_].begin(),
-        brave_cookie_rules_[off_the_record_].end(),
-        [primary_pattern, secondary_pattern, value](const auto& rule) {
-          return rule.primary_pattern == primary_pattern &&
-                 rule.secondary_pattern == secondary_pattern &&
-                 ValueToContentSetting(&rule.value) !=
-                    ValueToContentSetting(value); });
-    if (match != brave_cookie_rules_[off_the_record_].end()) {
+    const ContentSetting setting = ValueToContentSetting(in_value.get());
+    auto is_overridden = [&](const auto& rule) {
+      return rule.primary_pattern == primary_pattern &&
+             rule.secondary_pattern == secondary_pattern &&
+             ValueToContentSetting(&rule.value) != setting;
+    };
+    if (base::ranges::any_of(google_cookie_rules_, is_overridden) ||
+        base::ranges::any_of(brave_cookie_rules_[off_the_record_],
+                             is_overridden)) {
       // swap primary/secondary pattern - see CloneRule
       auto plugin_primary_pattern = secondary_pattern;
       auto plugin_secondary_pattern = primary_pattern;
@@ -426,10 +515,15 @@ std::unique_ptr<RuleIterator> BravePrefProvider::GetRuleIterator(
       bool incognito) const {
   if (content_type == ContentSettingsType::COOKIES) {
     std::vector<Rule> rules;
-    for (auto i = cookie_rules_.at(incognito).begin();
-         i != cookie_rules_.at(incognito).end();
-         ++i) {
-      rules.emplace_back(CloneRule(*i));
+    for (const auto& rule : google_cookie_rules_)
+      rules.emplace_back(CloneRule(rule));
+    for (const auto* cookie_rules :
+         {&chromium_cookie_rules_, &brave_cookie_rules_}) {
+      auto it = cookie_rules->find(incognito);
+      if (it == cookie_rules->end())
+        continue;
+      for (const auto& rule : it->second)
+        rules.emplace_back(CloneRule(rule));
     }
 
     return std::make_unique<BraveShieldsRuleIterator>(std::move(rules));
@@ -438,13 +532,8 @@ std::unique_ptr<RuleIterator> BravePrefProvider::GetRuleIterator(
   return PrefProvider::GetRuleIterator(content_type, incognito);
 }
 
-void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
-                                          bool incognito) {
-  auto& rules = cookie_rules_[incognito];
-  auto old_rules = std::move(brave_cookie_rules_[incognito]);
-
-  rules.clear();
-  brave_cookie_rules_[incognito].clear();
+void BravePrefProvider::UpdateGoogleCookieRules() {
+  google_cookie_rules_.clear();
 
   // kGoogleLoginControlType preference adds an exception for
   // accounts.google.com to access cookies in 3p context to allow login using
@@ -457,35 +546,42 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   // are tightly bound to google, and require google auth to work.
   // See: #5075, #9852, #10367
   if (prefs_->GetBoolean(kGoogleLoginControlType)) {
-    const auto google_auth_rule = Rule(
+    google_cookie_rules_.emplace_back(
         ContentSettingsPattern::FromString(kGoogleAuthPattern),
         ContentSettingsPattern::Wildcard(),
         base::Value::FromUniquePtrValue(
-                         ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-                     base::Time(), SessionModel::Durable);
-    rules.emplace_back(CloneRule(google_auth_rule));
-    brave_cookie_rules_[incognito].emplace_back(CloneRule(google_auth_rule));
-
-    const auto firebase_rule = Rule(
+            ContentSettingToValue(CONTENT_SETTING_ALLOW)),
+        base::Time(), SessionModel::Durable);
+    google_cookie_rules_.emplace_back(
         ContentSettingsPattern::FromString(kFirebasePattern),
         ContentSettingsPattern::Wildcard(),
         base::Value::FromUniquePtrValue(
             ContentSettingToValue(CONTENT_SETTING_ALLOW)),
         base::Time(), SessionModel::Durable);
-    rules.emplace_back(CloneRule(firebase_rule));
-    brave_cookie_rules_[incognito].emplace_back(CloneRule(firebase_rule));
   }
   // non-pref based exceptions should go in the cookie_settings_base.cc
   // chromium_src override
+}
 
-  // add chromium cookies
-  auto chromium_cookies_iterator = PrefProvider::GetRuleIterator(
-      ContentSettingsType::COOKIES,
-      incognito);
-  while (chromium_cookies_iterator && chromium_cookies_iterator->HasNext()) {
-    rules.emplace_back(CloneRule(chromium_cookies_iterator->Next()));
+void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
+                                          bool incognito) {
+  // Chromium cookie rules are passed through as they are, and nothing else
+  // depends on them.
+  if (content_type == ContentSettingsType::COOKIES || !initialized_) {
+    auto& chromium_rules = chromium_cookie_rules_[incognito];
+    chromium_rules.clear();
+    auto chromium_cookies_iterator =
+        PrefProvider::GetRuleIterator(ContentSettingsType::COOKIES, incognito);
+    while (chromium_cookies_iterator && chromium_cookies_iterator->HasNext()) {
+      chromium_rules.emplace_back(CloneRule(chromium_cookies_iterator->Next()));
+    }
   }
-  chromium_cookies_iterator.reset();
+  if (content_type == ContentSettingsType::COOKIES)
+    return;
+
+  auto& rules = brave_cookie_rules_[incognito];
+  auto old_rules = std::move(rules);
+  rules.clear();
 
   auto brave_shields_iterator = PrefProvider::GetRuleIterator(
       ContentSettingsType::BRAVE_SHIELDS, incognito);
@@ -497,6 +593,7 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   }
 
   brave_shields_iterator.reset();
+  const ShieldRulesIndex shield_rules_index(shield_rules);
 
   // add brave cookies after checking shield status
   auto brave_cookies_iterator = PrefProvider::GetRuleIterator(
@@ -505,10 +602,8 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   // Matching cookie rules against shield rules.
   while (brave_cookies_iterator && brave_cookies_iterator->HasNext()) {
     auto rule = brave_cookies_iterator->Next();
-    if (IsActive(rule, shield_rules)) {
+    if (IsActive(rule, shield_rules_index))
       rules.emplace_back(CloneRule(rule, true));
-      brave_cookie_rules_[incognito].emplace_back(CloneRule(rule, true));
-    }
   }
 
   // Adding shields down rules (they always override cookie rules).
@@ -525,63 +620,28 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
                base::Value::FromUniquePtrValue(
                    ContentSettingToValue(CONTENT_SETTING_ALLOW)),
                base::Time(), SessionModel::Durable));
-      brave_cookie_rules_[incognito].emplace_back(
-          Rule(ContentSettingsPattern::Wildcard(),
-               shield_rule.primary_pattern,
-               base::Value::FromUniquePtrValue(
-                   ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-               base::Time(), SessionModel::Durable));
     }
   }
 
-  // get the list of changes
-  std::vector<Rule> brave_cookie_updates;
-  for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
-      brave_cookie_updates.emplace_back(CloneRule(new_rule));
-    }
-  }
+  // Notify brave cookie changes as ContentSettingsType::COOKIES
+  if (initialized_)
+    PostNotifyChanges(old_rules, rules, incognito);
+}
 
-  // find any removed rules
-  for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
-      brave_cookie_updates.emplace_back(
-          Rule(old_rule.primary_pattern, old_rule.secondary_pattern,
-               base::Value(), old_rule.expiration, old_rule.session_model));
-    }
-  }
+void BravePrefProvider::PostNotifyChanges(const std::vector<Rule>& old_rules,
+                                          const std::vector<Rule>& new_rules,
+                                          bool incognito) {
+  std::vector<Rule> changes = GetChangedRules(old_rules, new_rules);
+  if (changes.empty())
+    return;
 
-  // Notify brave cookie changes as ContentSettingsType::COOKIES
-  if (initialized_ && (content_type == ContentSettingsType::BRAVE_COOKIES ||
-                       content_type == ContentSettingsType::BRAVE_SHIELDS)) {
-    // PostTask here to avoid content settings autolock DCHECK
-    base::PostTask(
-        FROM_HERE,
-        {content::BrowserThread::UI, base::TaskPriority::USER_VISIBLE},
-        base::BindOnce(&BravePrefProvider::NotifyChanges,
-                       weak_factory_.GetWeakPtr(),
-                       std::move(brave_cookie_updates), incognito));
-  }
+  // PostTask here to avoid content settings autolock DCHECK
+  base::PostTask(
+      FROM_HERE,
+      {content::BrowserThread::UI, base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&BravePrefProvider::NotifyChanges,
+                     weak_factory_.GetWeakPtr(), std::move(changes),
+                     incognito));
 }
 
 void BravePrefProvider::NotifyChanges(const std::vector<Rule>& rules,
@@ -594,12 +654,16 @@ void BravePrefProvider::NotifyChanges(const std::vector<Rule>& rules,
 
 void BravePrefProvider::OnCookiePrefsChanged(
     const std::string& pref) {
-  OnCookieSettingsChanged(ContentSettingsType::BRAVE_COOKIES);
+  auto old_rules = std::move(google_cookie_rules_);
+  UpdateGoogleCookieRules();
+  PostNotifyChanges(old_rules, google_cookie_rules_, off_the_record_);
 }
 
 void BravePrefProvider::OnCookieSettingsChanged(
     ContentSettingsType content_type) {
-  UpdateCookieRules(content_type, true);
+  // HostContentSettingsMap only asks regular profiles for regular rules
+  if (off_the_record_)
+    UpdateCookieRules(content_type, true);
   UpdateCookieRules(content_type, false);
 }
 
@@ -62,8 +62,12 @@ class BravePrefProvider : public PrefProvider,
       int setting);
   void MigrateShieldsSettingsV1ToV2();
   void MigrateShieldsSettingsV1ToV2ForOneType(ContentSettingsType content_type);
+  void UpdateGoogleCookieRules();
   void UpdateCookieRules(ContentSettingsType content_type, bool incognito);
   void OnCookieSettingsChanged(ContentSettingsType content_type);
+  void PostNotifyChanges(const std::vector<Rule>& old_rules,
+                         const std::vector<Rule>& new_rules,
+                         bool incognito);
   void NotifyChanges(const std::vector<Rule>& rules, bool incognito);
   bool SetWebsiteSettingInternal(
       const ContentSettingsPattern& primary_pattern,
@@ -78,7 +82,11 @@ class BravePrefProvider : public PrefProvider,
                                ContentSettingsType content_type) override;
   void OnCookiePrefsChanged(const std::string& pref);
 
-  std::map<bool /* is_incognito */, std::vector<Rule>> cookie_rules_;
+  // Cookie rules are kept in the order they are returned in, so that a change
+  // to one content type only rebuilds the rules derived from it. Regular
+  // profiles only keep the non-incognito rules.
+  std::vector<Rule> google_cookie_rules_;
+  std::map<bool /* is_incognito */, std::vector<Rule>> chromium_cookie_rules_;
   std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_rules_;
 
   bool initialized_;
@@ -4,6 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/macros.h"
@@ -524,4 +525,50 @@ TEST_F(BravePrefProviderTest, TestShieldsSettingsMigrationFromUnknownSettings) {
   provider.ShutdownOnUIThread();
 }
 
+TEST_F(BravePrefProviderTest, TestCookieRulesFollowShieldsState) {
+  BravePrefProvider provider(
+      testing_profile()->GetPrefs(), false /* incognito */,
+      true /* store_last_modified */, false /* restore_session */);
+
+  const GURL cookie_url("https://cdn.example.com");
+  const GURL a_url("https://www.a.com");
+  const GURL b_url("https://www.b.com");
+  auto set_setting = [&provider](const std::string& pattern,
+                                 ContentSettingsType content_type,
+                                 ContentSetting setting) {
+    provider.SetWebsiteSetting(ContentSettingsPattern::FromString(pattern),
+                               ContentSettingsPattern::Wildcard(),
+                               content_type, ContentSettingToValue(setting),
+                               {});
+  };
+  auto get_cookie_setting = [&provider, &cookie_url](const GURL& site_url) {
+    return TestUtils::GetContentSetting(&provider, cookie_url, site_url,
+                                        ContentSettingsType::COOKIES, false);
+  };
+
+  set_setting("[*.]a.com", ContentSettingsType::BRAVE_COOKIES,
+              CONTENT_SETTING_BLOCK);
+  set_setting("www.b.com", ContentSettingsType::BRAVE_COOKIES,
+              CONTENT_SETTING_BLOCK);
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(a_url));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(b_url));
+
+  // Shields down on a subdomain leaves the rule for the whole site alone,
+  // while shields down on a parent domain disables the site's rule.
+  set_setting("[*.]sub.a.com", ContentSettingsType::BRAVE_SHIELDS,
+              CONTENT_SETTING_BLOCK);
+  set_setting("[*.]b.com", ContentSettingsType::BRAVE_SHIELDS,
+              CONTENT_SETTING_BLOCK);
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(a_url));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW, get_cookie_setting(b_url));
+
+  // Shields back up
+  set_setting("[*.]b.com", ContentSettingsType::BRAVE_SHIELDS,
+              CONTENT_SETTING_DEFAULT);
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(a_url));
+  EXPECT_EQ(CONTENT_SETTING_BLOCK, get_cookie_setting(b_url));
+
+  provider.ShutdownOnUIThread();
+}
+
 }  //  namespace content_settings
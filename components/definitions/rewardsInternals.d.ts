@@ -9,6 +9,8 @@ declare namespace RewardsInternals {
       isKeyInfoSeedValid: boolean
       walletPaymentId: string
       bootStamp: number
+      mediaResolverHits: number
+      mediaResolverMisses: number
     }
     contributions: ContributionInfo[]
     promotions: Promotion[]
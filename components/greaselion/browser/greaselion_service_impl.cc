@@ -6,7 +6,10 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -16,11 +19,16 @@
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
@@ -50,28 +58,144 @@ namespace {
 
 constexpr char kRunAtDocumentStart[] = "document_start";
 
+// Converted extensions are kept in a subdirectory of the install directory,
+// one directory per rule named after the rule's content hash.
+constexpr char kConvertedExtensionsDirectory[] = "Extensions";
+
+// Bump this whenever the conversion below changes its output, so that
+// extensions converted by an older browser are rebuilt.
+constexpr char kConvertedExtensionFormat[] = "1";
+
+// The public key of a converted extension is derived from this endpoint and
+// the rule name.
+std::string GetPublicKeyPrefix() {
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    return UPDATER_DEV_ENDPOINT;
+  }
+  return UPDATER_PROD_ENDPOINT;
+}
+
+base::FilePath GetConvertedExtensionsDir(const base::FilePath& install_dir) {
+  return install_dir.AppendASCII(kConvertedExtensionsDirectory);
+}
+
+void AppendField(base::StringPiece field, std::string* content) {
+  content->append(base::NumberToString(field.size()));
+  content->push_back(':');
+  content->append(field.data(), field.size());
+}
+
+bool AppendFile(const base::FilePath& name,
+                const base::FilePath& path,
+                std::string* content) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return false;
+  AppendField(name.AsUTF8Unsafe(), content);
+  AppendField(contents, content);
+  return true;
+}
+
+// Hashes everything that ends up in the converted extension for |rule|.
+// Returns an empty string if any of the rule's files can't be read.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::string GetRuleContentKey(const greaselion::GreaselionRule& rule) {
+  std::string content;
+  AppendField(kConvertedExtensionFormat, &content);
+  AppendField(GetPublicKeyPrefix(), &content);
+  AppendField(rule.name(), &content);
+  AppendField(rule.run_at(), &content);
+  for (const std::string& url_pattern : rule.url_patterns())
+    AppendField(url_pattern, &content);
+
+  for (const base::FilePath& script : rule.scripts()) {
+    if (!AppendFile(script.BaseName(), script, &content))
+      return std::string();
+  }
+
+  if (!rule.messages().empty()) {
+    if (!base::DirectoryExists(rule.messages()))
+      return std::string();
+    std::vector<base::FilePath> files;
+    base::FileEnumerator traversal(rule.messages(), true,
+                                   base::FileEnumerator::FILES);
+    for (base::FilePath file = traversal.Next(); !file.empty();
+         file = traversal.Next()) {
+      files.push_back(file);
+    }
+    std::sort(files.begin(), files.end());
+    for (const base::FilePath& file : files) {
+      base::FilePath relative_path;
+      if (!rule.messages().AppendRelativePath(file, &relative_path) ||
+          !AppendFile(relative_path, file, &content)) {
+        return std::string();
+      }
+    }
+  }
+
+  return base::HexEncode(crypto::SHA256HashString(content).data(),
+                         crypto::kSHA256Length);
+}
+
+std::vector<greaselion::GreaselionServiceImpl::KeyedRule>
+GetRuleContentKeysOnTaskRunner(std::vector<greaselion::GreaselionRule> rules) {
+  std::vector<greaselion::GreaselionServiceImpl::KeyedRule> keyed_rules;
+  keyed_rules.reserve(rules.size());
+  for (const greaselion::GreaselionRule& rule : rules)
+    keyed_rules.emplace_back(rule, GetRuleContentKey(rule));
+  return keyed_rules;
+}
+
+// Deletes converted extensions that no longer belong to any rule.
+void PruneConvertedExtensionsOnTaskRunner(const base::FilePath& install_dir,
+                                          std::set<std::string> keys) {
+  base::FileEnumerator traversal(GetConvertedExtensionsDir(install_dir), false,
+                                 base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath dir = traversal.Next(); !dir.empty();
+       dir = traversal.Next()) {
+    if (!keys.count(dir.BaseName().AsUTF8Unsafe()))
+      base::DeletePathRecursively(dir);
+  }
+}
+
 // Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
-// extension that the caller should take ownership of, or nullptr.
+// an unpacked extension in the user data dir, under a directory named after
+// |key|, and reused from there as long as the rule's content doesn't change.
+// Returns a valid extension, or nullptr.
 //
 // NOTE: This function does file IO and should not be called on the UI thread.
-// NOTE: The caller takes ownership of the directory at extension->path() on the
-// returned object.
-base::Optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
-ConvertGreaselionRuleToExtensionOnTaskRunner(
+scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
     const greaselion::GreaselionRule& rule,
+    const std::string& key,
     const base::FilePath& install_dir) {
+  const base::FilePath extension_dir =
+      GetConvertedExtensionsDir(install_dir).AppendASCII(key);
+  std::string error;
+  if (base::DirectoryExists(extension_dir)) {
+    scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+        extension_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+    if (extension.get())
+      return extension;
+    // Left behind half written, convert the rule again.
+    base::DeletePathRecursively(extension_dir);
+  }
+
   base::FilePath install_temp_dir =
       extensions::file_util::GetInstallTempDir(install_dir);
   if (install_temp_dir.empty()) {
     LOG(ERROR) << "Could not get path to profile temp directory";
-    return base::nullopt;
+    return nullptr;
   }
 
   base::ScopedTempDir temp_dir;
   if (!temp_dir.CreateUniqueTempDirUnderPath(install_temp_dir)) {
     LOG(ERROR) << "Could not create Greaselion temp directory";
-    return base::nullopt;
+    return nullptr;
   }
 
   // Create the manifest
@@ -87,27 +211,17 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // rule name to a known Brave domain and hash the result to create a
   // public key.
   char raw[crypto::kSHA256Length] = {0};
-  std::string key;
+  std::string public_key;
   std::string script_name = rule.name();
-  const base::CommandLine& command_line =
-      *base::CommandLine::ForCurrentProcess();
-  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
-      !base::FeatureList::IsEnabled(
-          brave_component_updater::kUseDevUpdaterUrl)) {
-    crypto::SHA256HashString(UPDATER_DEV_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  } else {
-    crypto::SHA256HashString(UPDATER_PROD_ENDPOINT + script_name,
-                             raw,
-                             crypto::kSHA256Length);
-  }
-  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+  crypto::SHA256HashString(GetPublicKeyPrefix() + script_name, raw,
+                           crypto::kSHA256Length);
+  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length),
+                     &public_key);
 
   root->SetStringPath(extensions::manifest_keys::kName, script_name);
   root->SetStringPath(extensions::manifest_keys::kVersion, "1.0");
   root->SetStringPath(extensions::manifest_keys::kDescription, "");
-  root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
+  root->SetStringPath(extensions::manifest_keys::kPublicKey, public_key);
   root->SetStringPath("incognito",
                       extensions::manifest_values::kIncognitoNotAllowed);
 
@@ -149,7 +263,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // files to disk.
   if (!serializer.Serialize(*root)) {
     LOG(ERROR) << "Could not write Greaselion manifest";
-    return base::nullopt;
+    return nullptr;
   }
 
   // Copy the messages directory to our extension directory.
@@ -159,7 +273,7 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
             temp_dir.GetPath().AppendASCII("_locales"), true)) {
       LOG(ERROR) << "Could not copy Greaselion messages directory at path: "
                  << rule.messages().LossyDisplayName();
-      return base::nullopt;
+      return nullptr;
     }
   }
 
@@ -169,23 +283,30 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
                         temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script at path: "
           << script.LossyDisplayName();
-      return base::nullopt;
+      return nullptr;
     }
   }
 
-  std::string error;
+  // Only move the extension into place once it's complete, so a crash
+  // mid-conversion never leaves a directory that looks valid.
+  if (!base::CreateDirectory(extension_dir.DirName()) ||
+      !base::Move(temp_dir.GetPath(), extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension into place";
+    return nullptr;
+  }
+  ignore_result(temp_dir.Take());
+
   scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), Manifest::COMPONENT, Extension::NO_FLAGS, &error);
+      extension_dir, Manifest::COMPONENT, Extension::NO_FLAGS, &error);
   if (!extension.get()) {
     LOG(ERROR) << "Could not load Greaselion extension";
     LOG(ERROR) << error;
-    return base::nullopt;
+    return nullptr;
   }
 
-  // Take ownership of this temporary directory so it's deleted when
-  // the service exits
-  return std::make_pair(extension, std::move(temp_dir));
+  return extension;
 }
+
 }  // namespace
 
 namespace greaselion {
@@ -236,74 +357,104 @@ void GreaselionServiceImpl::UpdateInstalledExtensions() {
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
-    CreateAndInstallExtensions();
-    return;
-  }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
-    extension_service_->UnloadExtension(
-        id, extensions::UnloadedExtensionReason::UPDATE);
+  // Hash every rule, matching or not, so that extensions converted for rules
+  // which are merely switched off stay cached on disk.
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->has_unknown_preconditions() == false)
+      rules.push_back(*rule);
   }
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&GetRuleContentKeysOnTaskRunner, std::move(rules)),
+      base::BindOnce(&GreaselionServiceImpl::ReconcileExtensions,
+                     weak_factory_.GetWeakPtr()));
 }
 
-void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+void GreaselionServiceImpl::ReconcileExtensions(
+    std::vector<KeyedRule> keyed_rules) {
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
   pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+
+  std::set<std::string> keys;
+  std::map<std::string, const GreaselionRule*> wanted_rules;
+  for (const KeyedRule& keyed_rule : keyed_rules) {
+    const GreaselionRule& rule = keyed_rule.first;
+    const std::string& key = keyed_rule.second;
+    const bool matches = rule.Matches(state_, browser_version_);
+    if (key.empty()) {
+      if (matches) {
+        LOG(ERROR) << "Could not read Greaselion rule " << rule.name();
+        all_rules_installed_successfully_ = false;
+      }
+      continue;
+    }
+    keys.insert(key);
+    if (matches)
+      wanted_rules[key] = &rule;
+  }
+
+  // Unload only the extensions whose rule changed, went away or no longer
+  // matches. The ones left alone keep running without being reloaded.
+  std::vector<extensions::ExtensionId> unwanted_extensions;
+  for (auto it = installed_rules_.begin(); it != installed_rules_.end();) {
+    if (wanted_rules.count(it->first)) {
+      ++it;
+      continue;
     }
+    unwanted_extensions.push_back(it->second);
+    it = installed_rules_.erase(it);
+  }
+  for (const extensions::ExtensionId& id : unwanted_extensions) {
+    base::Erase(greaselion_extensions_, id);
+    extension_service_->UnloadExtension(
+        id, extensions::UnloadedExtensionReason::UPDATE);
+  }
+
+  for (const auto& wanted_rule : wanted_rules) {
+    if (installed_rules_.count(wanted_rule.first))
+      continue;
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    pending_installs_ += 1;
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       *wanted_rule.second, wanted_rule.first,
+                       install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), wanted_rule.first));
   }
+
+  // Runs after the conversions above, as the task runner is sequenced.
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&PruneConvertedExtensionsOnTaskRunner,
+                                install_directory_, std::move(keys)));
+
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // nothing changed, or every changed rule was switched off
     MaybeNotifyObservers();
-    return;
-  }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
-    base::Optional<GreaselionConvertedExtension> converted_extension) {
-  if (!converted_extension) {
+    const std::string& key,
+    scoped_refptr<extensions::Extension> extension) {
+  if (!extension) {
     all_rules_installed_successfully_ = false;
     pending_installs_ -= 1;
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(std::move(converted_extension->second));
+    installed_rules_[key] = extension->id();
+    greaselion_extensions_.push_back(extension->id());
     extension_system_->ready().Post(
         FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
                                   weak_factory_.GetWeakPtr(),
-                                  std::move(converted_extension->first)));
+                                  std::move(extension)));
   }
 }
 
@@ -336,11 +487,12 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     // not one of ours
     return;
   }
+  // Unloaded by someone else, so it has to be installed again on the next
+  // update.
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
-    // It's time!
-    CreateAndInstallExtensions();
-  }
+  base::EraseIf(installed_rules_, [&extension](const auto& installed_rule) {
+    return installed_rule.second == extension->id();
+  });
 }
 
 void GreaselionServiceImpl::AddObserver(Observer* observer) {
@@ -13,11 +13,11 @@
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
 #include "base/version.h"
+#include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
 #include "extensions/common/extension_id.h"
 #include "url/gurl.h"
@@ -35,8 +35,6 @@ class ExtensionSystem;
 
 namespace greaselion {
 
-class GreaselionDownloadService;
-
 class GreaselionServiceImpl : public GreaselionService {
  public:
   explicit GreaselionServiceImpl(
@@ -63,14 +61,15 @@ class GreaselionServiceImpl : public GreaselionService {
                            const extensions::Extension* extension,
                            extensions::UnloadedExtensionReason reason) override;
 
-  using GreaselionConvertedExtension =
-      std::pair<scoped_refptr<extensions::Extension>, base::ScopedTempDir>;
+  // A rule paired with the hash of everything its converted extension is
+  // built from. The hash is empty if the rule's files could not be read.
+  using KeyedRule = std::pair<GreaselionRule, std::string>;
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
-  void CreateAndInstallExtensions();
-  void PostConvert(
-      base::Optional<GreaselionConvertedExtension> converted_extension);
+  void ReconcileExtensions(std::vector<KeyedRule> keyed_rules);
+  void PostConvert(const std::string& key,
+                   scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -87,7 +86,8 @@ class GreaselionServiceImpl : public GreaselionService {
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::ScopedTempDir> extension_dirs_;
+  // Content hash of each rule that is currently converted and installed.
+  std::map<std::string, extensions::ExtensionId> installed_rules_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
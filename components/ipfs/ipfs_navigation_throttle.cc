@@ -129,6 +129,8 @@ IpfsNavigationThrottle::WillStartRequest() {
 
   // Check # of connected peers before using local node.
   if (is_local_mode && ipfs_service_->IsDaemonLaunched()) {
+    if (ipfs_service_->HasCachedConnectedPeers())
+      return content::NavigationThrottle::PROCEED;
     resume_pending_ = true;
     GetConnectedPeers();
     return content::NavigationThrottle::DEFER;
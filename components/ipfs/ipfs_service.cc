@@ -45,6 +45,10 @@ namespace {
 const int kMinimalPeersRetryIntervalMs = 350;
 const int kPeersRetryRate = 3;
 
+// A non-empty peer list is reused for this long instead of asking the daemon
+// again, so a burst of ipfs:// navigations needs a single swarm/peers call.
+const int kConnectedPeersCacheTTLSeconds = 5;
+
 net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTag() {
   return net::DefineNetworkTrafficAnnotation("ipfs_service", R"(
       semantics {
@@ -252,6 +256,7 @@ void IpfsService::Shutdown() {
 
   ipfs_service_.reset();
   ipfs_pid_ = -1;
+  connected_peers_.clear();
 }
 
 std::unique_ptr<network::SimpleURLLoader> IpfsService::CreateURLLoader(
@@ -287,13 +292,44 @@ void IpfsService::GetConnectedPeers(GetConnectedPeersCallback callback,
     return;
   }
 
+  if (HasCachedConnectedPeers()) {
+    // Reply asynchronously, callers don't expect to be re-entered.
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&IpfsService::OnCachedConnectedPeers,
+                       weak_factory_.GetWeakPtr(), std::move(callback),
+                       connected_peers_));
+    return;
+  }
+
+  // Null callbacks are queued too, so that the queue being non-empty means
+  // a request is in flight. Its result is shared by everyone waiting.
+  pending_connected_peers_callbacks_.push_back(std::move(callback));
+  if (pending_connected_peers_callbacks_.size() > 1)
+    return;
+
+  RequestConnectedPeers(retries);
+}
+
+bool IpfsService::HasCachedConnectedPeers() const {
+  return !connected_peers_.empty() &&
+         base::TimeTicks::Now() - connected_peers_time_ <
+             base::TimeDelta::FromSeconds(kConnectedPeersCacheTTLSeconds);
+}
+
+void IpfsService::RequestConnectedPeers(int retries) {
+  if (!IsDaemonLaunched()) {
+    RunConnectedPeersCallbacks(false, std::vector<std::string>{});
+    return;
+  }
+
   auto url_loader = CreateURLLoader(server_endpoint_.Resolve(kSwarmPeersPath));
   auto iter = url_loaders_.insert(url_loaders_.begin(), std::move(url_loader));
 
   iter->get()->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
       url_loader_factory_.get(),
       base::BindOnce(&IpfsService::OnGetConnectedPeers, base::Unretained(this),
-                     std::move(iter), std::move(callback), retries));
+                     std::move(iter), retries));
 }
 
 base::TimeDelta IpfsService::CalculatePeersRetryTime() {
@@ -306,7 +342,6 @@ base::TimeDelta IpfsService::CalculatePeersRetryTime() {
 
 void IpfsService::OnGetConnectedPeers(
     SimpleURLLoaderList::iterator iter,
-    GetConnectedPeersCallback callback,
     int retry_number,
     std::unique_ptr<std::string> response_body) {
   auto* url_loader = iter->get();
@@ -319,9 +354,8 @@ void IpfsService::OnGetConnectedPeers(
   if (error_code == net::ERR_CONNECTION_REFUSED && retry_number) {
     base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
         FROM_HERE,
-        base::BindOnce(&IpfsService::GetConnectedPeers,
-                       weak_factory_.GetWeakPtr(), std::move(callback),
-                       retry_number - 1),
+        base::BindOnce(&IpfsService::RequestConnectedPeers,
+                       weak_factory_.GetWeakPtr(), retry_number - 1),
         CalculatePeersRetryTime());
     return;
   }
@@ -336,14 +370,44 @@ void IpfsService::OnGetConnectedPeers(
   if (success)
     success = IPFSJSONParser::GetPeersFromJSON(*response_body, &peers);
 
-  if (callback)
-    std::move(callback).Run(success, peers);
+  // Only cache a usable answer, callers keep polling while there are no peers.
+  if (success && !peers.empty()) {
+    connected_peers_ = peers;
+    connected_peers_time_ = base::TimeTicks::Now();
+  } else {
+    connected_peers_.clear();
+  }
+
+  RunConnectedPeersCallbacks(success, peers);
 
   for (auto& observer : observers_) {
     observer.OnGetConnectedPeers(success, peers);
   }
 }
 
+void IpfsService::OnCachedConnectedPeers(
+    GetConnectedPeersCallback callback,
+    const std::vector<std::string>& peers) {
+  if (callback)
+    std::move(callback).Run(true, peers);
+
+  for (auto& observer : observers_) {
+    observer.OnGetConnectedPeers(true, peers);
+  }
+}
+
+void IpfsService::RunConnectedPeersCallbacks(
+    bool success,
+    const std::vector<std::string>& peers) {
+  // Callbacks may ask for peers again, which has to start a new request.
+  std::vector<GetConnectedPeersCallback> callbacks;
+  callbacks.swap(pending_connected_peers_callbacks_);
+  for (auto& callback : callbacks) {
+    if (callback)
+      std::move(callback).Run(success, peers);
+  }
+}
+
 void IpfsService::GetAddressesConfig(GetAddressesConfigCallback callback) {
   if (!IsDaemonLaunched()) {
     std::move(callback).Run(false, AddressesConfig());
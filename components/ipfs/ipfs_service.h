@@ -15,6 +15,7 @@
 #include "base/containers/queue.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/observer_list.h"
+#include "base/time/time.h"
 #include "brave/components/ipfs/addresses_config.h"
 #include "brave/components/ipfs/brave_ipfs_client_updater.h"
 #include "brave/components/ipfs/ipfs_constants.h"
@@ -94,8 +95,12 @@ class IpfsService : public KeyedService,
 
   void RestartDaemon();
 
+  // Concurrent calls share one request to the daemon, and a non-empty peer
+  // list is reused for a few seconds after it was fetched.
   void GetConnectedPeers(GetConnectedPeersCallback callback,
                          int retries = kPeersDefaultRetries);
+  // Returns true if the daemon reported connected peers moments ago.
+  bool HasCachedConnectedPeers() const;
   void GetAddressesConfig(GetAddressesConfigCallback callback);
   void LaunchDaemon(LaunchDaemonCallback callback);
   void ShutdownDaemon(ShutdownDaemonCallback callback);
@@ -134,10 +139,14 @@ class IpfsService : public KeyedService,
   base::TimeDelta CalculatePeersRetryTime();
   std::unique_ptr<network::SimpleURLLoader> CreateURLLoader(const GURL& gurl);
 
+  void RequestConnectedPeers(int retries);
   void OnGetConnectedPeers(SimpleURLLoaderList::iterator iter,
-                           GetConnectedPeersCallback,
                            int retries,
                            std::unique_ptr<std::string> response_body);
+  void OnCachedConnectedPeers(GetConnectedPeersCallback callback,
+                              const std::vector<std::string>& peers);
+  void RunConnectedPeersCallbacks(bool success,
+                                  const std::vector<std::string>& peers);
   void OnGetAddressesConfig(SimpleURLLoaderList::iterator iter,
                             GetAddressesConfigCallback callback,
                             std::unique_ptr<std::string> response_body);
@@ -165,6 +174,11 @@ class IpfsService : public KeyedService,
   SimpleURLLoaderList url_loaders_;
 
   base::queue<LaunchDaemonCallback> pending_launch_callbacks_;
+  std::vector<GetConnectedPeersCallback> pending_connected_peers_callbacks_;
+
+  // Last non-empty peer list reported by the daemon.
+  std::vector<std::string> connected_peers_;
+  base::TimeTicks connected_peers_time_;
 
   bool allow_ipfs_launch_for_test_ = false;
   bool skip_get_connected_peers_callback_for_test_ = false;
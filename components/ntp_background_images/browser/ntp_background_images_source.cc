@@ -11,9 +11,10 @@
 #include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/files/file_path.h"
-#include "base/memory/ref_counted_memory.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
@@ -35,15 +36,42 @@ bool IsSuperReferralPath(const std::string& path) {
   return path.rfind(kSuperReferralPath, 0) == 0;
 }
 
+// Enough for the current and next wallpaper with their logos
+constexpr size_t kImageCacheSize = 4;
+
+void RecordImageLoadTime(bool cached, base::TimeTicks start_time) {
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - start_time;
+  if (cached) {
+    UMA_HISTOGRAM_TIMES("Brave.NTP.BackgroundImageLoadTime.Warm", elapsed);
+  } else {
+    UMA_HISTOGRAM_TIMES("Brave.NTP.BackgroundImageLoadTime.Cold", elapsed);
+  }
+}
+
+void RunWithLoadTime(bool cached,
+                     base::TimeTicks start_time,
+                     content::URLDataSource::GotDataCallback callback,
+                     scoped_refptr<base::RefCountedMemory> bytes) {
+  if (bytes)
+    RecordImageLoadTime(cached, start_time);
+  std::move(callback).Run(std::move(bytes));
+}
+
 }  // namespace
 
 NTPBackgroundImagesSource::NTPBackgroundImagesSource(
     NTPBackgroundImagesService* service)
     : service_(service),
+      image_cache_(kImageCacheSize),
       weak_factory_(this) {
+  if (service_)
+    service_->AddObserver(this);
 }
 
-NTPBackgroundImagesSource::~NTPBackgroundImagesSource() = default;
+NTPBackgroundImagesSource::~NTPBackgroundImagesSource() {
+  if (service_)
+    service_->RemoveObserver(this);
+}
 
 std::string NTPBackgroundImagesSource::GetSource() {
   return kBrandedWallpaperHost;
@@ -88,34 +116,100 @@ void NTPBackgroundImagesSource::StartDataRequest(
     }
   } else {
     DCHECK(IsWallpaperPath(path));
-    image_file_path =
-        images_data->backgrounds[GetWallpaperIndexFromPath(path)].image_file;
+    const int wallpaper_index = GetWallpaperIndexFromPath(path);
+    image_file_path = images_data->backgrounds[wallpaper_index].image_file;
+    GetImageFile(image_file_path, std::move(callback));
+    PrefetchNextWallpaper(*images_data, wallpaper_index);
+    return;
   }
 
   GetImageFile(image_file_path, std::move(callback));
 }
 
+void NTPBackgroundImagesSource::OnUpdated(NTPBackgroundImagesData* data) {
+  // Component files may have been replaced
+  generation_++;
+  image_cache_.Clear();
+}
+
+void NTPBackgroundImagesSource::OnSuperReferralEnded() {
+  generation_++;
+  image_cache_.Clear();
+}
+
 void NTPBackgroundImagesSource::GetImageFile(
     const base::FilePath& image_file_path,
     GotDataCallback callback) {
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
+  auto cached = image_cache_.Get(image_file_path);
+  if (cached != image_cache_.end()) {
+    RunWithLoadTime(true, start_time, std::move(callback), cached->second);
+    return;
+  }
+
+  const bool is_reading = pending_reads_.count(image_file_path) > 0;
+  pending_reads_[image_file_path].push_back(base::BindOnce(
+      &RunWithLoadTime, false, start_time, std::move(callback)));
+  if (!is_reading)
+    ReadImageFile(image_file_path);
+}
+
+void NTPBackgroundImagesSource::ReadImageFile(
+    const base::FilePath& image_file_path) {
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
       base::BindOnce(&ReadFileToString, image_file_path),
       base::BindOnce(&NTPBackgroundImagesSource::OnGotImageFile,
                      weak_factory_.GetWeakPtr(),
-                     std::move(callback)));
+                     image_file_path,
+                     generation_));
 }
 
 void NTPBackgroundImagesSource::OnGotImageFile(
-    GotDataCallback callback,
+    const base::FilePath& image_file_path,
+    int generation,
     base::Optional<std::string> input) {
-  if (!input)
-    return;
+  std::vector<GotDataCallback> callbacks;
+  auto pending = pending_reads_.find(image_file_path);
+  if (pending != pending_reads_.end()) {
+    callbacks = std::move(pending->second);
+    pending_reads_.erase(pending);
+  }
 
   scoped_refptr<base::RefCountedMemory> bytes;
-  bytes = new base::RefCountedBytes(
-       reinterpret_cast<const unsigned char*>(input->c_str()), input->length());
-  std::move(callback).Run(std::move(bytes));
+  if (input) {
+    bytes = base::RefCountedString::TakeString(&input.value());
+    if (generation == generation_)
+      image_cache_.Put(image_file_path, bytes);
+  }
+
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+void NTPBackgroundImagesSource::PrefetchNextWallpaper(
+    const NTPBackgroundImagesData& images_data,
+    int wallpaper_index) {
+  // ViewCounterModel shows the wallpapers in order.
+  const int wallpaper_count = images_data.backgrounds.size();
+  if (wallpaper_count < 2)
+    return;
+
+  const auto& next_background =
+      images_data.backgrounds[(wallpaper_index + 1) % wallpaper_count];
+  std::vector<base::FilePath> image_file_paths = {next_background.image_file};
+  if (next_background.logo)
+    image_file_paths.push_back(next_background.logo->image_file);
+
+  for (const auto& image_file_path : image_file_paths) {
+    if (image_cache_.Peek(image_file_path) != image_cache_.end() ||
+        pending_reads_.count(image_file_path))
+      continue;
+
+    pending_reads_[image_file_path];
+    ReadImageFile(image_file_path);
+  }
 }
 
 std::string NTPBackgroundImagesSource::GetMimeType(const std::string& path) {
@@ -6,22 +6,26 @@
 #ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SOURCE_H_
 #define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_BACKGROUND_IMAGES_SOURCE_H_
 
+#include <map>
 #include <string>
+#include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/optional.h"
+#include "brave/components/ntp_background_images/browser/ntp_background_images_service.h"
 #include "content/public/browser/url_data_source.h"
 
-namespace base {
-class FilePath;
-}  // namespace base
-
 namespace ntp_background_images {
 
-class NTPBackgroundImagesService;
-
 // This serves background image data.
-class NTPBackgroundImagesSource : public content::URLDataSource {
+// Recently served images are kept in memory and the wallpaper following the
+// one served is read ahead of time, as that is the one the view counter picks
+// for the next new tab page.
+class NTPBackgroundImagesSource : public content::URLDataSource,
+                                  public NTPBackgroundImagesService::Observer {
  public:
   explicit NTPBackgroundImagesSource(NTPBackgroundImagesService* service);
 
@@ -35,6 +39,8 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest, BasicTest);
   FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
                            BasicSuperReferralDataTest);
+  FRIEND_TEST_ALL_PREFIXES(NTPBackgroundImagesSourceTest,
+                           CachesAndPrefetchesImages);
 
   // content::URLDataSource overrides:
   std::string GetSource() override;
@@ -44,10 +50,18 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   std::string GetMimeType(const std::string& path) override;
   bool AllowCaching() override;
 
+  // NTPBackgroundImagesService::Observer overrides:
+  void OnUpdated(NTPBackgroundImagesData* data) override;
+  void OnSuperReferralEnded() override;
+
   void GetImageFile(const base::FilePath& image_file_path,
                     GotDataCallback callback);
-  void OnGotImageFile(GotDataCallback callback,
+  void ReadImageFile(const base::FilePath& image_file_path);
+  void OnGotImageFile(const base::FilePath& image_file_path,
+                      int generation,
                       base::Optional<std::string> input);
+  void PrefetchNextWallpaper(const NTPBackgroundImagesData& images_data,
+                             int wallpaper_index);
   bool IsValidPath(const std::string& path) const;
   bool IsLogoPath(const std::string& path) const;
   bool IsDefaultLogoPath(const std::string& path) const;
@@ -58,6 +72,15 @@ class NTPBackgroundImagesSource : public content::URLDataSource {
   base::FilePath GetTopSiteFaviconFilePath(const std::string& path) const;
 
   NTPBackgroundImagesService* service_;  // not owned
+
+  base::MRUCache<base::FilePath, scoped_refptr<base::RefCountedMemory>>
+      image_cache_;
+  // Callbacks waiting for a file read that is in progress. Prefetches have
+  // no callback.
+  std::map<base::FilePath, std::vector<GotDataCallback>> pending_reads_;
+  // Incremented when images change so that reads started before are not
+  // cached.
+  int generation_ = 0;
   base::WeakPtrFactory<NTPBackgroundImagesSource> weak_factory_;
 };
 
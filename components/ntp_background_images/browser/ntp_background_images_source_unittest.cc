@@ -6,7 +6,9 @@
 #include <memory>
 #include <string>
 
-#include "base/test/task_environment.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
 #include "brave/components/brave_referrals/browser/brave_referrals_service.h"
 #include "brave/components/brave_referrals/buildflags/buildflags.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
@@ -14,6 +16,7 @@
 #include "brave/components/ntp_background_images/browser/ntp_background_images_source.h"
 #include "brave/components/ntp_background_images/common/pref_names.h"
 #include "components/prefs/testing_pref_service.h"
+#include "content/public/test/browser_task_environment.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace ntp_background_images {
@@ -32,7 +35,7 @@ class NTPBackgroundImagesSourceTest : public testing::Test {
                     base::Value(base::Value::Type::DICTIONARY));
   }
 
-  base::test::SingleThreadTaskEnvironment task_environment;
+  content::BrowserTaskEnvironment task_environment;
   TestingPrefServiceSimple local_pref_;
   std::unique_ptr<NTPBackgroundImagesService> service_;
   std::unique_ptr<NTPBackgroundImagesSource> source_;
@@ -78,6 +81,68 @@ TEST_F(NTPBackgroundImagesSourceTest, BasicTest) {
       source_->GetWallpaperIndexFromPath("sponsored-images/wallpaper-3.jpg"));
 }
 
+TEST_F(NTPBackgroundImagesSourceTest, CachesAndPrefetchesImages) {
+  const std::string test_json_string = R"(
+      {
+        "schemaVersion": 1,
+        "logo": {
+          "imageUrl": "logo.png",
+          "alt": "Technikke: For music lovers",
+          "companyName": "Technikke",
+          "destinationUrl": "https://www.brave.com/?from-super-referreer-demo"
+        },
+        "wallpapers": [
+          {
+            "imageUrl": "background-1.jpg"
+          },
+          {
+            "imageUrl": "background-2.jpg"
+          }
+        ]
+      })";
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath first_path =
+      temp_dir.GetPath().AppendASCII("background-1.jpg");
+  const base::FilePath second_path =
+      temp_dir.GetPath().AppendASCII("background-2.jpg");
+  ASSERT_TRUE(base::WriteFile(first_path, "first"));
+  ASSERT_TRUE(base::WriteFile(second_path, "second"));
+  service_->si_installed_dir_ = temp_dir.GetPath();
+  service_->OnGetComponentJsonData(false, test_json_string);
+
+  auto request = [this](const std::string& path) {
+    std::string data;
+    source_->StartDataRequest(
+        GURL("chrome://branded-wallpaper/" + path),
+        content::WebContents::Getter(),
+        base::BindOnce(
+            [](std::string* data,
+               scoped_refptr<base::RefCountedMemory> bytes) {
+              if (bytes)
+                data->assign(bytes->front_as<char>(), bytes->size());
+            },
+            &data));
+    task_environment.RunUntilIdle();
+    return data;
+  };
+
+  EXPECT_EQ("first", request("sponsored-images/wallpaper-0.jpg"));
+  // The next wallpaper is read ahead of time.
+  EXPECT_NE(source_->image_cache_.Peek(second_path),
+            source_->image_cache_.end());
+
+  // Served from memory once read.
+  ASSERT_TRUE(base::DeleteFile(first_path));
+  ASSERT_TRUE(base::DeleteFile(second_path));
+  EXPECT_EQ("first", request("sponsored-images/wallpaper-0.jpg"));
+  EXPECT_EQ("second", request("sponsored-images/wallpaper-1.jpg"));
+
+  // Updated component data invalidates the cache.
+  service_->OnGetComponentJsonData(false, test_json_string);
+  EXPECT_EQ("", request("sponsored-images/wallpaper-0.jpg"));
+}
+
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
 
 #if !defined(OS_LINUX)
@@ -0,0 +1,165 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_substring_index.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "base/check_op.h"
+
+namespace {
+
+// Ends every site in the concatenation, so no suffix runs into the next site.
+const char kSiteSeparator = '\0';
+
+}  // namespace
+
+SiteSubstringIndex::SiteSubstringIndex(const std::vector<std::string>& sites) {
+  for (const auto& site : sites) {
+    DCHECK_EQ(site.find(kSiteSeparator), std::string::npos);
+    site_offsets_.push_back(static_cast<uint32_t>(text_.size()));
+    text_.append(site);
+    text_.push_back(kSiteSeparator);
+  }
+
+  // Suffixes only ever need comparing up to the end of their own site, so a
+  // plain sort is cheap enough for lists of this size.
+  for (const auto offset : site_offsets_) {
+    for (uint32_t i = offset; text_[i] != kSiteSeparator; ++i)
+      suffix_array_.push_back(i);
+  }
+  std::sort(suffix_array_.begin(), suffix_array_.end(),
+            [this](uint32_t a, uint32_t b) {
+              const base::StringPiece suffix_a = SuffixAt(a);
+              const base::StringPiece suffix_b = SuffixAt(b);
+              return suffix_a < suffix_b || (suffix_a == suffix_b && a < b);
+            });
+
+  for (size_t i = 0; i < sites.size(); ++i)
+    sorted_sites_.push_back(i);
+  std::stable_sort(
+      sorted_sites_.begin(), sorted_sites_.end(),
+      [&sites](size_t a, size_t b) { return sites[a] < sites[b]; });
+
+  const size_t size = suffix_array_.size();
+  min_tree_.resize(2 * size);
+  for (size_t i = 0; i < size; ++i)
+    min_tree_[size + i] = static_cast<uint32_t>(i);
+  for (size_t node = size; node-- > 1;) {
+    const uint32_t left = min_tree_[2 * node];
+    const uint32_t right = min_tree_[2 * node + 1];
+    min_tree_[node] =
+        suffix_array_[left] < suffix_array_[right] ? left : right;
+  }
+}
+
+SiteSubstringIndex::~SiteSubstringIndex() = default;
+
+std::vector<SiteSubstringIndex::Match> SiteSubstringIndex::FindMatches(
+    base::StringPiece text,
+    size_t max_matches) const {
+  std::vector<Match> matches;
+  if (text.empty() || max_matches == 0)
+    return matches;
+
+  // Pops occurrences in offset order by splitting the range around the lowest
+  // offset each time. Only the first occurrence of each site is kept, which
+  // is the lowest offset within that site.
+  struct Range {
+    uint32_t offset;
+    size_t position;
+    size_t begin;
+    size_t end;
+    bool operator>(const Range& other) const { return offset > other.offset; }
+  };
+  std::priority_queue<Range, std::vector<Range>, std::greater<Range>> ranges;
+  auto push_range = [&](size_t begin, size_t end) {
+    if (begin >= end)
+      return;
+    const size_t position = FindLowestOffset(begin, end);
+    ranges.push({suffix_array_[position], position, begin, end});
+  };
+
+  const auto range = FindRange(text);
+  push_range(range.first, range.second);
+  while (!ranges.empty() && matches.size() < max_matches) {
+    const Range next = ranges.top();
+    ranges.pop();
+    const Match match = ToMatch(next.offset);
+    if (matches.empty() || matches.back().index != match.index)
+      matches.push_back(match);
+    push_range(next.begin, next.position);
+    push_range(next.position + 1, next.end);
+  }
+  return matches;
+}
+
+std::vector<size_t> SiteSubstringIndex::FindPrefixMatches(
+    base::StringPiece text) const {
+  const auto begin = std::lower_bound(
+      sorted_sites_.begin(), sorted_sites_.end(), text,
+      [this](size_t index, base::StringPiece value) {
+        return SiteAt(index) < value;
+      });
+  const auto end = std::upper_bound(
+      begin, sorted_sites_.end(), text,
+      [this](base::StringPiece value, size_t index) {
+        return value < SiteAt(index).substr(0, value.size());
+      });
+  std::vector<size_t> indices(begin, end);
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+base::StringPiece SiteSubstringIndex::SiteAt(size_t index) const {
+  return SuffixAt(site_offsets_[index]);
+}
+
+base::StringPiece SiteSubstringIndex::SuffixAt(uint32_t offset) const {
+  const size_t end = text_.find(kSiteSeparator, offset);
+  return base::StringPiece(text_).substr(offset, end - offset);
+}
+
+std::pair<size_t, size_t> SiteSubstringIndex::FindRange(
+    base::StringPiece text) const {
+  const auto begin = std::lower_bound(
+      suffix_array_.begin(), suffix_array_.end(), text,
+      [this](uint32_t offset, base::StringPiece value) {
+        return SuffixAt(offset) < value;
+      });
+  const auto end = std::upper_bound(
+      begin, suffix_array_.end(), text,
+      [this](base::StringPiece value, uint32_t offset) {
+        return value < SuffixAt(offset).substr(0, value.size());
+      });
+  return {begin - suffix_array_.begin(), end - suffix_array_.begin()};
+}
+
+size_t SiteSubstringIndex::FindLowestOffset(size_t begin, size_t end) const {
+  DCHECK_LT(begin, end);
+  const size_t size = suffix_array_.size();
+  size_t lowest = begin;
+  for (size_t l = begin + size, r = end + size; l < r; l /= 2, r /= 2) {
+    if (l & 1) {
+      if (suffix_array_[min_tree_[l]] < suffix_array_[lowest])
+        lowest = min_tree_[l];
+      ++l;
+    }
+    if (r & 1) {
+      --r;
+      if (suffix_array_[min_tree_[r]] < suffix_array_[lowest])
+        lowest = min_tree_[r];
+    }
+  }
+  return lowest;
+}
+
+SiteSubstringIndex::Match SiteSubstringIndex::ToMatch(uint32_t offset) const {
+  const auto it =
+      std::upper_bound(site_offsets_.begin(), site_offsets_.end(), offset) - 1;
+  return {static_cast<size_t>(it - site_offsets_.begin()), offset - *it};
+}
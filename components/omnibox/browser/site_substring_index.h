@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_SUBSTRING_INDEX_H_
+#define BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_SUBSTRING_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+// Finds which sites of a fixed list contain some text, in list order. Lookups
+// take time proportional to the length of the text and the number of results
+// asked for, not to the length of the list.
+//
+// The sites are concatenated and indexed with a suffix array, so the suffixes
+// starting with the text form one range of it. Suffixes are numbered by their
+// offset in the concatenation, which orders them by site and then position.
+// A min-tree over those offsets then hands out the range in list order.
+class SiteSubstringIndex {
+ public:
+  struct Match {
+    size_t index;     // into the list of sites
+    size_t position;  // of the first occurrence of the text in the site
+  };
+
+  explicit SiteSubstringIndex(const std::vector<std::string>& sites);
+  ~SiteSubstringIndex();
+
+  // Returns up to |max_matches| sites containing |text|, in list order.
+  std::vector<Match> FindMatches(base::StringPiece text,
+                                 size_t max_matches) const;
+
+  // Returns the indices of the sites starting with |text|, in list order.
+  std::vector<size_t> FindPrefixMatches(base::StringPiece text) const;
+
+ private:
+  base::StringPiece SiteAt(size_t index) const;
+  base::StringPiece SuffixAt(uint32_t offset) const;
+  // Range of |suffix_array_| holding the suffixes that start with |text|.
+  std::pair<size_t, size_t> FindRange(base::StringPiece text) const;
+  // Position in |suffix_array_| of the lowest offset within [begin, end).
+  size_t FindLowestOffset(size_t begin, size_t end) const;
+  Match ToMatch(uint32_t offset) const;
+
+  std::string text_;
+  std::vector<uint32_t> site_offsets_;
+  std::vector<uint32_t> suffix_array_;
+  // Indices of the sites, sorted by site.
+  std::vector<size_t> sorted_sites_;
+  // Bottom-up segment tree over |suffix_array_|, each node holding the
+  // position of the lowest offset below it.
+  std::vector<uint32_t> min_tree_;
+
+  DISALLOW_COPY_AND_ASSIGN(SiteSubstringIndex);
+};
+
+#endif  // BRAVE_COMPONENTS_OMNIBOX_BROWSER_SITE_SUBSTRING_INDEX_H_
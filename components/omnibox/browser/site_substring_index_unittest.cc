@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/omnibox/browser/site_substring_index.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=SiteSubstringIndexTest.*
+
+namespace {
+
+const std::vector<std::string> kSites = {
+    "google.com", "youtube.com", "facebook.com", "bing.com",
+    "gogoanime.io", "google.co.uk", "coinbase.com", "com.com",
+};
+
+// The linear scan the index replaces
+std::vector<std::pair<size_t, size_t>> FindLinear(const std::string& text,
+                                                  size_t max_matches) {
+  std::vector<std::pair<size_t, size_t>> matches;
+  for (size_t i = 0; i < kSites.size() && matches.size() < max_matches; ++i) {
+    const size_t position = kSites[i].find(text);
+    if (position != std::string::npos)
+      matches.emplace_back(i, position);
+  }
+  return matches;
+}
+
+std::vector<std::pair<size_t, size_t>> FindIndexed(
+    const SiteSubstringIndex& index,
+    const std::string& text,
+    size_t max_matches) {
+  std::vector<std::pair<size_t, size_t>> matches;
+  for (const auto& match : index.FindMatches(text, max_matches))
+    matches.emplace_back(match.index, match.position);
+  return matches;
+}
+
+}  // namespace
+
+TEST(SiteSubstringIndexTest, MatchesLinearScan) {
+  const SiteSubstringIndex index(kSites);
+  for (const std::string text :
+       {"g", "go", "goo", "google.co", "o", "oo", "co", "com", ".com", "c",
+        "m", "book", "moc", "io", "e.co", "google.com", "google.com."}) {
+    for (const size_t max_matches : {1u, 2u, 5u, 100u}) {
+      EXPECT_EQ(FindLinear(text, max_matches),
+                FindIndexed(index, text, max_matches))
+          << text << " " << max_matches;
+    }
+  }
+}
+
+TEST(SiteSubstringIndexTest, ReportsFirstOccurrence) {
+  const SiteSubstringIndex index(kSites);
+  const auto matches = index.FindMatches("com", 100);
+  ASSERT_FALSE(matches.empty());
+  EXPECT_EQ(7u, matches.back().index);
+  EXPECT_EQ(0u, matches.back().position);
+}
+
+TEST(SiteSubstringIndexTest, EmptyInput) {
+  const SiteSubstringIndex index(kSites);
+  EXPECT_TRUE(index.FindMatches("", 100).empty());
+  EXPECT_TRUE(index.FindMatches("google", 0).empty());
+
+  const SiteSubstringIndex empty_index({});
+  EXPECT_TRUE(empty_index.FindMatches("google", 100).empty());
+  EXPECT_TRUE(empty_index.FindPrefixMatches("google").empty());
+}
+
+TEST(SiteSubstringIndexTest, PrefixMatches) {
+  const SiteSubstringIndex index(kSites);
+  EXPECT_EQ(std::vector<size_t>({0, 4, 5}), index.FindPrefixMatches("go"));
+  EXPECT_EQ(std::vector<size_t>({0, 5}), index.FindPrefixMatches("google.co"));
+  EXPECT_EQ(std::vector<size_t>({6, 7}), index.FindPrefixMatches("co"));
+  EXPECT_TRUE(index.FindPrefixMatches("oogle").empty());
+  EXPECT_TRUE(index.FindPrefixMatches("google.com.").empty());
+}
@@ -17,6 +17,7 @@
 #include "components/omnibox/browser/autocomplete_provider.h"
 
 class AutocompleteProviderClient;
+class SiteSubstringIndex;
 
 // This is the provider for Brave Suggested Sites
 class SuggestedSitesProvider : public AutocompleteProvider {
@@ -32,6 +33,8 @@ class SuggestedSitesProvider : public AutocompleteProvider {
   static const int kRelevance;
 
   const std::vector<SuggestedSitesMatch>& GetSuggestedSites();
+  // Prefix index over the match strings of GetSuggestedSites().
+  const SiteSubstringIndex& GetSuggestedSitesIndex();
   void AddMatch(const SuggestedSitesMatch& match,
                 const ACMatchClassifications& styles);
 
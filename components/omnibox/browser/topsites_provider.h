@@ -16,6 +16,7 @@
 #include "components/omnibox/browser/autocomplete_provider.h"
 
 class AutocompleteProviderClient;
+class SiteSubstringIndex;
 
 // This is the provider for top Alexa 500 sites URLs
 class TopSitesProvider : public AutocompleteProvider {
@@ -32,6 +33,9 @@ class TopSitesProvider : public AutocompleteProvider {
 
   static std::vector<std::string> top_sites_;
 
+  // Substring index over |top_sites_|, shared by all providers.
+  static const SiteSubstringIndex& GetTopSitesIndex();
+
   void AddMatch(const base::string16& match_string,
                 const ACMatchClassifications& styles);
 
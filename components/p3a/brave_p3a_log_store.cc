@@ -5,6 +5,7 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
@@ -22,6 +23,9 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Noisy histograms may update their values many times a second.
+constexpr base::TimeDelta kPersistDelay = base::TimeDelta::FromSeconds(10);
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -51,28 +55,25 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
-  LogEntry& entry = log_[histogram_name];
+  auto inserted = log_.emplace(histogram_name, LogEntry());
+  LogEntry& entry = inserted.first->second;
+  if (!inserted.second && entry.value == value) {
+    return;
+  }
   entry.value = value;
   if (!entry.sent) {
     DCHECK(entry.sent_timestamp.is_null());
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  MarkDirty(histogram_name);
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
   DCHECK(delegate_->IsActualMetric(histogram_name));
   log_.erase(histogram_name);
   unsent_entries_.erase(histogram_name);
-
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->RemovePath(histogram_name);
+  MarkDirty(histogram_name);
 
   if (has_staged_log() && staged_entry_key_ == histogram_name) {
     staged_entry_key_.clear();
@@ -82,20 +83,17 @@ void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
+      dirty_entries_.insert(pair.first);
     }
   }
+  // Otherwise a crash could skip the answers of the whole next period.
+  CommitPendingWrite();
 
   RecordP3A(log_.size() - unsent_entries_.size());
 
@@ -167,12 +165,9 @@ void BraveP3ALogStore::DiscardStagedLog() {
   DCHECK(log_iter != log_.end());
   log_iter->second.MarkAsSent();
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+  // Persist right away, so a crash can't make us send the value again.
+  dirty_entries_.insert(log_iter->first);
+  CommitPendingWrite();
 
   // Erase the entry from the unsent queue.
   auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
@@ -185,6 +180,45 @@ void BraveP3ALogStore::DiscardStagedLog() {
 
 void BraveP3ALogStore::MarkStagedLogAsSent() {}
 
+void BraveP3ALogStore::CommitPendingWrite() {
+  persist_timer_.Stop();
+  if (dirty_entries_.empty()) {
+    return;
+  }
+
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const auto& name : dirty_entries_) {
+    auto log_iter = log_.find(name);
+    if (log_iter == log_.end()) {
+      update->RemovePath(name);
+      continue;
+    }
+
+    const LogEntry& entry = log_iter->second;
+    update->SetPath({name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({name, kLogSentKey}, base::Value(entry.sent));
+    // Entries which were never sent have no timestamp persisted.
+    const base::Value* persisted = update->FindDictKey(name);
+    if (entry.sent || (persisted && persisted->FindKey(kLogTimestampKey))) {
+      update->SetPath({name, kLogTimestampKey},
+                      base::Value(entry.sent_timestamp.ToDoubleT()));
+    }
+  }
+  dirty_entries_.clear();
+}
+
+void BraveP3ALogStore::MarkDirty(const std::string& histogram_name) {
+  dirty_entries_.insert(histogram_name);
+  // Not restarted by later changes, which bounds how stale prefs can get.
+  if (!persist_timer_.IsRunning()) {
+    persist_timer_.Start(
+        FROM_HERE, kPersistDelay,
+        base::BindOnce(&BraveP3ALogStore::CommitPendingWrite,
+                       base::Unretained(this)));
+  }
+}
+
 void BraveP3ALogStore::TrimAndPersistUnsentLogs() {
   NOTREACHED();
 }
@@ -12,6 +12,7 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
@@ -19,10 +20,12 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
-// All logs (not only unsent are persistent), and all logs could be loaded
-// using |LoadPersistedUnsentLogs()|. We should fix this at some point since
-// for now persisted entries never expire.
+// Stores all given values in memory and persists them in prefs. Value changes
+// are batched and written at most |kPersistDelay| later, while changes of the
+// sent state are written immediately. All logs (not only unsent are
+// persistent), and all logs could be loaded using |LoadPersistedUnsentLogs()|.
+// We should fix this at some point since for now persisted entries never
+// expire.
 class BraveP3ALogStore : public metrics::LogStore {
  public:
   class Delegate {
@@ -48,6 +51,9 @@ class BraveP3ALogStore : public metrics::LogStore {
   void RemoveValueIfExists(const std::string& histogram_name);
   // Marks all saved values as unsent.
   void ResetUploadStamps();
+  // Writes the pending changes to prefs. Should be called before local state
+  // is committed on shutdown.
+  void CommitPendingWrite();
 
   // metrics::LogStore:
   bool has_unsent_logs() const override;
@@ -84,12 +90,18 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Schedules a write of |histogram_name| to prefs.
+  void MarkDirty(const std::string& histogram_name);
+
   Delegate* const delegate_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
+  // Entries which differ from prefs, removed ones included.
+  base::flat_set<std::string> dirty_entries_;
+  base::OneShotTimer persist_timer_;
 
   std::string staged_entry_key_;
   std::string staged_log_;
@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/p3a/brave_p3a_log_store.h"
+
+#include <memory>
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BraveP3ALogStoreTest.*
+
+namespace brave {
+
+namespace {
+
+constexpr char kPrefName[] = "p3a.logs";
+constexpr char kHistogram[] = "Brave.Test.Histogram";
+
+class TestDelegate : public BraveP3ALogStore::Delegate {
+ public:
+  std::string Serialize(base::StringPiece histogram_name,
+                        uint64_t value) override {
+    return histogram_name.as_string() + ":" + base::NumberToString(value);
+  }
+
+  bool IsActualMetric(base::StringPiece histogram_name) const override {
+    return true;
+  }
+};
+
+}  // namespace
+
+class BraveP3ALogStoreTest : public testing::Test {
+ public:
+  BraveP3ALogStoreTest() {
+    BraveP3ALogStore::RegisterPrefs(local_state_.registry());
+  }
+
+  std::unique_ptr<BraveP3ALogStore> CreateLogStore() {
+    auto log_store =
+        std::make_unique<BraveP3ALogStore>(&delegate_, &local_state_);
+    log_store->LoadPersistedUnsentLogs();
+    return log_store;
+  }
+
+  const base::Value* GetPersistedEntry(const std::string& histogram_name) {
+    return local_state_.GetDictionary(kPrefName)->FindDictKey(histogram_name);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple local_state_;
+  TestDelegate delegate_;
+};
+
+TEST_F(BraveP3ALogStoreTest, BatchesValueChanges) {
+  auto log_store = CreateLogStore();
+  for (uint64_t value = 0; value < 100; value++) {
+    log_store->UpdateValue(kHistogram, value);
+  }
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(GetPersistedEntry(kHistogram));
+
+  task_environment_.FastForwardUntilNoTasksRemain();
+  const base::Value* entry = GetPersistedEntry(kHistogram);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("99", *entry->FindStringKey("value"));
+  EXPECT_FALSE(*entry->FindBoolKey("sent"));
+  EXPECT_FALSE(entry->FindKey("timestamp"));
+}
+
+TEST_F(BraveP3ALogStoreTest, PersistsSentStateImmediately) {
+  auto log_store = CreateLogStore();
+  log_store->UpdateValue(kHistogram, 3);
+  log_store->StageNextLog();
+  EXPECT_EQ("Brave.Test.Histogram:3", log_store->staged_log());
+  log_store->DiscardStagedLog();
+
+  const base::Value* entry = GetPersistedEntry(kHistogram);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ("3", *entry->FindStringKey("value"));
+  EXPECT_TRUE(*entry->FindBoolKey("sent"));
+  EXPECT_TRUE(entry->FindDoubleKey("timestamp"));
+
+  log_store->ResetUploadStamps();
+  entry = GetPersistedEntry(kHistogram);
+  ASSERT_TRUE(entry);
+  EXPECT_FALSE(*entry->FindBoolKey("sent"));
+  EXPECT_EQ(0, *entry->FindDoubleKey("timestamp"));
+}
+
+TEST_F(BraveP3ALogStoreTest, CommitPendingWriteRestoresState) {
+  auto log_store = CreateLogStore();
+  log_store->UpdateValue(kHistogram, 1);
+  log_store->UpdateValue("Brave.Test.Removed", 2);
+  log_store->RemoveValueIfExists("Brave.Test.Removed");
+  log_store->CommitPendingWrite();
+  EXPECT_TRUE(GetPersistedEntry(kHistogram));
+  EXPECT_FALSE(GetPersistedEntry("Brave.Test.Removed"));
+
+  auto restored = CreateLogStore();
+  ASSERT_TRUE(restored->has_unsent_logs());
+  restored->StageNextLog();
+  EXPECT_EQ("Brave.Test.Histogram:1", restored->staged_log());
+  restored->DiscardStagedLog();
+  EXPECT_FALSE(restored->has_unsent_logs());
+}
+
+}  // namespace brave
@@ -280,6 +280,12 @@ void BraveP3AService::Init(
   }
 }
 
+void BraveP3AService::CommitPendingWrite() {
+  if (log_store_) {
+    log_store_->CommitPendingWrite();
+  }
+}
+
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) {
   // TRACE_EVENT0("brave_p3a", "SerializeMessage");
@@ -47,6 +47,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Writes the batched log changes to local state. Must be called on shutdown
+  // before local state is committed.
+  void CommitPendingWrite();
+
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) override;
@@ -210,6 +210,23 @@ void BatAdsClientMojoBridge::GetBrowsingHistory(
       base::BindOnce(&OnGetBrowsingHistory, std::move(callback)));
 }
 
+void OnGetHtmlHead(const ads::GetHtmlHeadCallback& callback,
+                   const std::string& html) {
+  callback(html);
+}
+
+void BatAdsClientMojoBridge::GetHtmlHead(const int32_t tab_id,
+                                         const std::string& url,
+                                         ads::GetHtmlHeadCallback callback) {
+  if (!connected()) {
+    callback("");
+    return;
+  }
+
+  bat_ads_client_->GetHtmlHead(
+      tab_id, url, base::BindOnce(&OnGetHtmlHead, std::move(callback)));
+}
+
 void BatAdsClientMojoBridge::RecordP2AEvent(
     const std::string& name,
     const ads::P2AEventType type,
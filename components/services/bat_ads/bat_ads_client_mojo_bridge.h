@@ -65,6 +65,10 @@ class BatAdsClientMojoBridge
                           const int days_ago,
                           ads::GetBrowsingHistoryCallback callback) override;
 
+  void GetHtmlHead(const int32_t tab_id,
+                   const std::string& url,
+                   ads::GetHtmlHeadCallback callback) override;
+
   void RecordP2AEvent(
       const std::string& name,
       const ads::P2AEventType type,
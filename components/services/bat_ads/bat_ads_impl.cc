@@ -70,10 +70,9 @@ void BatAdsImpl::OnAdsSubdivisionTargetingCodeHasChanged() {
   ads_->OnAdsSubdivisionTargetingCodeHasChanged();
 }
 
-void BatAdsImpl::OnHtmlLoaded(const int32_t tab_id,
-                              const std::vector<std::string>& redirect_chain,
-                              const std::string& html) {
-  ads_->OnHtmlLoaded(tab_id, redirect_chain, html);
+void BatAdsImpl::OnPageLoaded(const int32_t tab_id,
+                              const std::vector<std::string>& redirect_chain) {
+  ads_->OnPageLoaded(tab_id, redirect_chain);
 }
 
 void BatAdsImpl::OnTextLoaded(const int32_t tab_id,
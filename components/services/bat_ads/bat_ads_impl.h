@@ -48,9 +48,8 @@ class BatAdsImpl :
 
   void OnAdsSubdivisionTargetingCodeHasChanged() override;
 
-  void OnHtmlLoaded(const int32_t tab_id,
-                    const std::vector<std::string>& redirect_chain,
-                    const std::string& html) override;
+  void OnPageLoaded(const int32_t tab_id,
+                    const std::vector<std::string>& redirect_chain) override;
 
   void OnTextLoaded(const int32_t tab_id,
                     const std::vector<std::string>& redirect_chain,
@@ -172,6 +172,29 @@ void AdsClientMojoBridge::GetBrowsingHistory(
       std::bind(AdsClientMojoBridge::OnGetBrowsingHistory, holder, _1));
 }
 
+// static
+void AdsClientMojoBridge::OnGetHtmlHead(
+    CallbackHolder<GetHtmlHeadCallback>* holder,
+    const std::string& html) {
+  DCHECK(holder);
+
+  if (holder->is_valid()) {
+    std::move(holder->get()).Run(html);
+  }
+
+  delete holder;
+}
+
+void AdsClientMojoBridge::GetHtmlHead(const int32_t tab_id,
+                                      const std::string& url,
+                                      GetHtmlHeadCallback callback) {
+  // this gets deleted in OnGetHtmlHead
+  auto* holder = new CallbackHolder<GetHtmlHeadCallback>(
+      AsWeakPtr(), std::move(callback));
+  ads_client_->GetHtmlHead(
+      tab_id, url, std::bind(AdsClientMojoBridge::OnGetHtmlHead, holder, _1));
+}
+
 void AdsClientMojoBridge::RecordP2AEvent(
     const std::string& name,
     const ads::P2AEventType type,
@@ -70,6 +70,10 @@ class AdsClientMojoBridge
                           const int days_ago,
                           GetBrowsingHistoryCallback callback) override;
 
+  void GetHtmlHead(const int32_t tab_id,
+                   const std::string& url,
+                   GetHtmlHeadCallback callback) override;
+
   void RecordP2AEvent(
       const std::string& name,
       const ads::P2AEventType type,
@@ -173,6 +177,9 @@ class AdsClientMojoBridge
       CallbackHolder<GetBrowsingHistoryCallback>* holder,
       const std::vector<std::string>& history);
 
+  static void OnGetHtmlHead(CallbackHolder<GetHtmlHeadCallback>* holder,
+                            const std::string& html);
+
   static void OnLoad(
       CallbackHolder<LoadCallback>* holder,
       const ads::Result result,
@@ -147,17 +147,18 @@ void BatLedgerImpl::OnBackground(uint32_t tab_id, uint64_t current_time) {
 
 void BatLedgerImpl::OnPostData(const std::string& url,
     const std::string& first_party_url, const std::string& referrer,
-    const std::string& post_data, ledger::type::VisitDataPtr visit_data) {
-  ledger_->OnPostData(
-      url, first_party_url, referrer, post_data, std::move(visit_data));
+    const std::string& post_data, const std::string& media_type,
+    ledger::type::VisitDataPtr visit_data) {
+  ledger_->OnPostData(url, first_party_url, referrer, post_data, media_type,
+                      std::move(visit_data));
 }
 
 void BatLedgerImpl::OnXHRLoad(uint32_t tab_id, const std::string& url,
     const base::flat_map<std::string, std::string>& parts,
     const std::string& first_party_url, const std::string& referrer,
-    ledger::type::VisitDataPtr visit_data) {
+    const std::string& media_type, ledger::type::VisitDataPtr visit_data) {
     ledger_->OnXHRLoad(tab_id, url, parts,
-        first_party_url, referrer, std::move(visit_data));
+        first_party_url, referrer, media_type, std::move(visit_data));
 }
 
 // static
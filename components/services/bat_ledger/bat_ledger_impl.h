@@ -69,10 +69,12 @@ class BatLedgerImpl :
       const std::string& first_party_url,
       const std::string& referrer,
       const std::string& post_data,
+      const std::string& media_type,
       ledger::type::VisitDataPtr visit_data) override;
   void OnXHRLoad(uint32_t tab_id, const std::string& url,
       const base::flat_map<std::string, std::string>& parts,
       const std::string& first_party_url, const std::string& referrer,
+      const std::string& media_type,
       ledger::type::VisitDataPtr visit_data) override;
 
   void SetPublisherExclude(
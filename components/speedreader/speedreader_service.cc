@@ -53,11 +53,13 @@ void StoreTogglesHistogram(uint64_t toggles) {
   UMA_HISTOGRAM_EXACT_LINEAR(kSpeedreaderToggleUMAHistogramName, bucket, 5);
 }
 
-void RecordHistograms(PrefService* prefs, bool toggled, bool enabled_now) {
-  WeeklyStorage weekly_toggles(prefs, kSpeedreaderPrefToggleCount);
+void RecordHistograms(PrefService* prefs,
+                      WeeklyStorage* weekly_toggles,
+                      bool toggled,
+                      bool enabled_now) {
   if (toggled)
-    weekly_toggles.AddDelta(1);
-  const uint64_t toggle_count = weekly_toggles.GetWeeklySum();
+    weekly_toggles->AddDelta(1);
+  const uint64_t toggle_count = weekly_toggles->GetWeeklySum();
   StoreTogglesHistogram(toggle_count);
 
   // Has been "recently" enabled if currently enabled,
@@ -74,7 +76,11 @@ void RecordHistograms(PrefService* prefs, bool toggled, bool enabled_now) {
 
 }  // namespace
 
-SpeedreaderService::SpeedreaderService(PrefService* prefs) : prefs_(prefs) {}
+SpeedreaderService::SpeedreaderService(PrefService* prefs,
+                                       WeeklyStorage* weekly_toggles)
+    : prefs_(prefs), weekly_toggles_(weekly_toggles) {
+  DCHECK(weekly_toggles_);
+}
 
 SpeedreaderService::~SpeedreaderService() {}
 
@@ -90,7 +96,7 @@ void SpeedreaderService::ToggleSpeedreader() {
   prefs_->SetBoolean(kSpeedreaderPrefEnabled, !enabled);
   if (!enabled)
     prefs_->SetBoolean(kSpeedreaderPrefEverEnabled, true);
-  RecordHistograms(prefs_, true,
+  RecordHistograms(prefs_, weekly_toggles_, true,
                    !enabled);  // toggling - now enabled
 }
 
@@ -100,7 +106,7 @@ bool SpeedreaderService::IsEnabled() {
   }
 
   const bool enabled = prefs_->GetBoolean(kSpeedreaderPrefEnabled);
-  RecordHistograms(prefs_, false, enabled);
+  RecordHistograms(prefs_, weekly_toggles_, false, enabled);
   return enabled;
 }
 
@@ -12,12 +12,15 @@
 
 class PrefRegistrySimple;
 class PrefService;
+class WeeklyStorage;
 
 namespace speedreader {
 
 class SpeedreaderService : public KeyedService {
  public:
-  explicit SpeedreaderService(PrefService* prefs);
+  // |weekly_toggles| must be the storage of the toggle count pref and outlive
+  // the service.
+  SpeedreaderService(PrefService* prefs, WeeklyStorage* weekly_toggles);
   ~SpeedreaderService() override;
 
   static void RegisterPrefs(PrefRegistrySimple* registry);
@@ -30,6 +33,7 @@ class SpeedreaderService : public KeyedService {
 
  private:
   PrefService* prefs_ = nullptr;
+  WeeklyStorage* weekly_toggles_ = nullptr;
 };
 
 }  // namespace speedreader
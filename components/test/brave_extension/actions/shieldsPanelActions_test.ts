@@ -58,14 +58,14 @@ describe('shieldsPanelActions', () => {
     })
   })
 
-  it('resourceBlocked action', () => {
-    const details: BlockDetails = {
+  it('resourcesBlocked action', () => {
+    const details: BlockDetails[] = [{
       blockType: 'shieldsAds',
       tabId: 2,
       subresource: 'https://www.brave.com/test'
-    }
-    expect(actions.resourceBlocked(details)).toEqual({
-      type: types.RESOURCE_BLOCKED,
+    }]
+    expect(actions.resourcesBlocked(details)).toEqual({
+      type: types.RESOURCES_BLOCKED,
       details
     })
   })
@@ -416,7 +416,7 @@ describe('braveShieldsPanelReducer', () => {
     })
   })
 
-  describe('RESOURCE_BLOCKED', () => {
+  describe('RESOURCES_BLOCKED', () => {
     let spy: jest.SpyInstance
     beforeEach(() => {
       spy = jest.spyOn(browserActionAPI, 'setBadgeText')
@@ -439,24 +439,24 @@ describe('braveShieldsPanelReducer', () => {
         }
       }
       shieldsPanelReducer(stateWithBlockStats, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'javascript',
           tabId: 2,
           subresource: 'https://a.com/index.js'
-        }
+        }]
       })
       expect(spy).toBeCalledTimes(1)
       expect(spy.mock.calls[0][1]).toBe('12')
     })
     it('increments for JS blocking', () => {
       let nextState = shieldsPanelReducer(state, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'javascript',
           tabId: 2,
           subresource: 'https://test.brave.com/index.js'
-        }
+        }]
       })
 
       expect(nextState).toEqual({
@@ -475,12 +475,12 @@ describe('braveShieldsPanelReducer', () => {
     })
     it('increments JS blocking consecutively', () => {
       let nextState = shieldsPanelReducer(state, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'javascript',
           tabId: 2,
           subresource: 'https://a.com/index.js'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -497,12 +497,12 @@ describe('braveShieldsPanelReducer', () => {
       })
 
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'javascript',
           tabId: 2,
           subresource: 'https://b.com/index.js'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -521,12 +521,12 @@ describe('braveShieldsPanelReducer', () => {
     })
     it('increments for fingerprinting blocked', () => {
       let nextState = shieldsPanelReducer(state, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'fingerprinting',
           tabId: 2,
           subresource: 'https://test.brave.com'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -542,12 +542,12 @@ describe('braveShieldsPanelReducer', () => {
     })
     it('increases same count consecutively', () => {
       let nextState = shieldsPanelReducer(state, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: 2,
           subresource: 'https://test.brave.com'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -562,12 +562,12 @@ describe('braveShieldsPanelReducer', () => {
       })
 
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: 2,
           subresource: 'https://test2.brave.com'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -587,24 +587,24 @@ describe('braveShieldsPanelReducer', () => {
     it('increases same count consecutively without duplicates', () => {
       const tabId = 2
       let nextState = shieldsPanelReducer(state, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: tabId,
           subresource: 'https://test.brave.com'
-        }
+        }]
       })
       expect(nextState.tabs[tabId].adsBlockedResources).toEqual(
         [ 'https://test.brave.com' ]
       )
 
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: tabId,
           subresource: 'https://test2.brave.com'
-        }
+        }]
       })
       expect(nextState.tabs[tabId].adsBlockedResources).toEqual(
         [
@@ -614,12 +614,12 @@ describe('braveShieldsPanelReducer', () => {
       )
 
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: tabId,
           subresource: 'https://test2.brave.com'
-        }
+        }]
       })
       expect(nextState.tabs[tabId].adsBlockedResources).toEqual(
         [
@@ -630,12 +630,12 @@ describe('braveShieldsPanelReducer', () => {
     })
     it('increases different tab counts separately', () => {
       let nextState = deepFreeze(shieldsPanelReducer(state, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: 2,
           subresource: 'https://test.brave.com'
-        }
+        }]
       }))
       expect(nextState).toEqual({
         ...state,
@@ -652,12 +652,12 @@ describe('braveShieldsPanelReducer', () => {
       })
 
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: 3,
           subresource: 'https://test.brave.com'
-        }
+        }]
       })
 
       expect(nextState).toEqual({
@@ -686,12 +686,12 @@ describe('braveShieldsPanelReducer', () => {
     })
     it('increases different resource types separately', () => {
       let nextState = deepFreeze(shieldsPanelReducer(state, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'shieldsAds',
           tabId: 2,
           subresource: 'https://test.brave.com'
-        }
+        }]
       }))
       expect(nextState).toEqual({
         ...state,
@@ -706,12 +706,12 @@ describe('braveShieldsPanelReducer', () => {
       })
 
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'trackers',
           tabId: 2,
           subresource: 'https://test.brave.com'
-        }
+        }]
       })
 
       expect(nextState).toEqual({
@@ -729,12 +729,12 @@ describe('braveShieldsPanelReducer', () => {
       })
 
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'httpUpgradableResources',
           tabId: 2,
           subresource: 'https://test.brave.com'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -752,12 +752,12 @@ describe('braveShieldsPanelReducer', () => {
         }
       })
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'javascript',
           tabId: 2,
           subresource: 'https://test.brave.com/index.js'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -779,12 +779,12 @@ describe('braveShieldsPanelReducer', () => {
         }
       })
       nextState = shieldsPanelReducer(nextState, {
-        type: types.RESOURCE_BLOCKED,
-        details: {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
           blockType: 'fingerprinting',
           tabId: 2,
           subresource: 'https://test.brave.com'
-        }
+        }]
       })
       expect(nextState).toEqual({
         ...state,
@@ -808,6 +808,30 @@ describe('braveShieldsPanelReducer', () => {
         }
       })
     })
+    it('updates the badge text once for the whole batch', () => {
+      const nextState = shieldsPanelReducer(state, {
+        type: types.RESOURCES_BLOCKED,
+        details: [{
+          blockType: 'shieldsAds',
+          tabId: 2,
+          subresource: 'https://a.com/ad.js'
+        }, {
+          blockType: 'shieldsAds',
+          tabId: 2,
+          subresource: 'https://b.com/ad.js'
+        }, {
+          blockType: 'shieldsAds',
+          tabId: 2,
+          subresource: 'https://a.com/ad.js'
+        }]
+      })
+      expect(nextState.tabs[2].adsBlocked).toBe(2)
+      expect(nextState.tabs[2].adsBlockedResources).toEqual([
+        'https://a.com/ad.js',
+        'https://b.com/ad.js'
+      ])
+      expect(spy).toBeCalledTimes(1)
+    })
   })
 
   describe('BLOCK_ADS_TRACKERS', () => {
@@ -212,7 +212,7 @@ export const getMockChrome = () => {
       }
     },
     braveShields: {
-      onBlocked: new ChromeEvent(),
+      onResourcesBlocked: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
@@ -300,7 +300,7 @@ export const getMockChrome = () => {
       create: function (data: any) {
         return Promise.resolve()
       },
-      onBlocked: new ChromeEvent(),
+      onResourcesBlocked: new ChromeEvent(),
       allowScriptsOnce: function (origins: Array<string>, tabId: number, cb: () => void) {
         setImmediate(cb)
       },
@@ -5,9 +5,10 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
+#include <algorithm>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
@@ -19,9 +20,15 @@ constexpr size_t kDaysInWeek = 7;
 }
 
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
+    : WeeklyStorage(prefs, pref_name, base::TimeDelta()) {}
+
+WeeklyStorage::WeeklyStorage(PrefService* prefs,
+                             const char* pref_name,
+                             base::TimeDelta save_delay)
     : prefs_(prefs),
       pref_name_(pref_name),
-      clock_(std::make_unique<base::DefaultClock>()) {
+      clock_(std::make_unique<base::DefaultClock>()),
+      save_delay_(save_delay) {
   DCHECK(pref_name);
   if (prefs) {
     Load();
@@ -37,12 +44,14 @@ WeeklyStorage::WeeklyStorage(PrefService* prefs,
   Load();
 }
 
-WeeklyStorage::~WeeklyStorage() = default;
+WeeklyStorage::~WeeklyStorage() {
+  Flush();
+}
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
   FilterToWeek();
   daily_values_.front().value += delta;
-  Save();
+  ScheduleSave();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
@@ -51,45 +60,34 @@ void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
   if (today.value < value) {
     today.value = value;
   }
-  Save();
+  ScheduleSave();
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  uint64_t sum = 0;
+  for (const auto& daily_value : daily_values_) {
+    // Check only last continious days.
+    if (daily_value.day > n_days_ago) {
+      sum += daily_value.value;
+    }
+  }
+  return sum;
 }
 
 uint64_t WeeklyStorage::GetHighestValueInWeek() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  std::list<DailyValue> last_weeks_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   last_weeks_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  last_weeks_daily_values.resize(
-      std::distance(last_weeks_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(last_weeks_daily_values.begin(),
-                                     last_weeks_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == last_weeks_daily_values.end()) {
-    return 0;
+  uint64_t highest = 0;
+  for (const auto& daily_value : daily_values_) {
+    if (daily_value.day > n_days_ago) {
+      highest = std::max(highest, daily_value.value);
+    }
   }
-  return highest_it->value;
+  return highest;
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
@@ -98,8 +96,22 @@ bool WeeklyStorage::IsOneWeekPassed() const {
   return daily_values_.size() == kDaysInWeek;
 }
 
+void WeeklyStorage::Flush() {
+  if (!save_timer_.IsRunning()) {
+    return;
+  }
+
+  save_timer_.Stop();
+  Save();
+}
+
 void WeeklyStorage::FilterToWeek() {
-  base::Time now_midnight = clock_->Now().LocalMidnight();
+  const base::Time now = clock_->Now();
+  if (!daily_values_.empty() && now >= today_start_ && now < today_end_) {
+    return;
+  }
+
+  base::Time now_midnight = now.LocalMidnight();
   base::Time last_saved_midnight;
 
   if (!daily_values_.empty()) {
@@ -114,6 +126,12 @@ void WeeklyStorage::FilterToWeek() {
       daily_values_.pop_back();
     }
   }
+
+  today_start_ = now_midnight;
+  // Days are not always 24 hours long, so look up the next midnight from the
+  // middle of tomorrow.
+  today_end_ =
+      (now_midnight + base::TimeDelta::FromHours(36)).LocalMidnight();
 }
 
 void WeeklyStorage::Load() {
@@ -136,6 +154,19 @@ void WeeklyStorage::Load() {
   }
 }
 
+void WeeklyStorage::ScheduleSave() {
+  if (save_delay_.is_zero()) {
+    Save();
+    return;
+  }
+
+  if (!save_timer_.IsRunning()) {
+    save_timer_.Start(FROM_HERE, save_delay_,
+                      base::BindOnce(&WeeklyStorage::Save,
+                                     base::Unretained(this)));
+  }
+}
+
 void WeeklyStorage::Save() {
   DCHECK(!daily_values_.empty());
   DCHECK_LE(daily_values_.size(), kDaysInWeek);
@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
 #include <memory>
 
+#include "base/containers/circular_deque.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
@@ -22,9 +23,16 @@ class PrefService;
 // Requires |pref_name| to be already registered.
 // Feel free to improve and refactor it - templatize a stored value type,
 // change weekly interval or make a keyed service from it.
+//
+// Instances shared through WeeklyStorageRegistry keep the daily values in
+// memory and write them to prefs at most once per |save_delay|, so frequent
+// updates are cheap.
 class WeeklyStorage {
  public:
   WeeklyStorage(PrefService* prefs, const char* pref_name);
+  WeeklyStorage(PrefService* prefs,
+                const char* pref_name,
+                base::TimeDelta save_delay);
 
   // For tests.
   WeeklyStorage(PrefService* user_prefs,
@@ -41,6 +49,9 @@ class WeeklyStorage {
   uint64_t GetHighestValueInWeek() const;
   bool IsOneWeekPassed() const;
 
+  // Writes pending changes to prefs.
+  void Flush();
+
  private:
   struct DailyValue {
     base::Time day;
@@ -48,13 +59,22 @@ class WeeklyStorage {
   };
   void FilterToWeek();
   void Load();
+  void ScheduleSave();
   void Save();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
+  const base::TimeDelta save_delay_;
+  base::OneShotTimer save_timer_;
+
+  // Most recent day first.
+  base::circular_deque<DailyValue> daily_values_;
 
-  std::list<DailyValue> daily_values_;
+  // Bounds of the day |daily_values_.front()| was last checked against, so
+  // that adding to today's value does not need to compute local midnight.
+  base::Time today_start_;
+  base::Time today_end_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
@@ -0,0 +1,42 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include "brave/components/weekly_storage/weekly_storage.h"
+
+namespace {
+
+constexpr base::TimeDelta kSaveDelay = base::TimeDelta::FromSeconds(30);
+
+}  // namespace
+
+WeeklyStorageRegistry::WeeklyStorageRegistry(PrefService* prefs)
+    : prefs_(prefs) {
+  DCHECK(prefs_);
+}
+
+WeeklyStorageRegistry::~WeeklyStorageRegistry() = default;
+
+WeeklyStorage* WeeklyStorageRegistry::Get(const char* pref_name) {
+  DCHECK(pref_name);
+
+  // WeeklyStorage keeps the raw name, so hand it the map key, which lives as
+  // long as the storage does, rather than the caller's string.
+  auto it = storages_.find(pref_name);
+  if (it == storages_.end()) {
+    it = storages_.emplace(pref_name, nullptr).first;
+    it->second =
+        std::make_unique<WeeklyStorage>(prefs_, it->first.c_str(), kSaveDelay);
+  }
+
+  return it->second.get();
+}
+
+void WeeklyStorageRegistry::Shutdown() {
+  for (const auto& storage : storages_) {
+    storage.second->Flush();
+  }
+}
@@ -0,0 +1,43 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "components/keyed_service/core/keyed_service.h"
+
+class PrefService;
+class WeeklyStorage;
+
+// Owns one live WeeklyStorage per pref of |prefs|, so that every recorder of
+// the same pref shares its in-memory values instead of loading and saving the
+// pref for each event. Pending values are written to prefs on shutdown.
+class WeeklyStorageRegistry : public KeyedService {
+ public:
+  explicit WeeklyStorageRegistry(PrefService* prefs);
+  ~WeeklyStorageRegistry() override;
+
+  WeeklyStorageRegistry(const WeeklyStorageRegistry&) = delete;
+  WeeklyStorageRegistry& operator=(const WeeklyStorageRegistry&) = delete;
+
+  // Returns the storage for |pref_name|, which must be a registered list pref.
+  // The name is copied, so it only needs to be valid for the duration of the
+  // call. The returned storage is owned by the registry and lives until the
+  // registry is destroyed.
+  WeeklyStorage* Get(const char* pref_name);
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  PrefService* prefs_ = nullptr;  // NOT OWNED
+  std::map<std::string, std::unique_ptr<WeeklyStorage>> storages_;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
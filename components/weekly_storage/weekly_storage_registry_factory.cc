@@ -0,0 +1,41 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+#include "components/keyed_service/content/browser_context_dependency_manager.h"
+#include "components/user_prefs/user_prefs.h"
+
+// static
+WeeklyStorageRegistryFactory* WeeklyStorageRegistryFactory::GetInstance() {
+  return base::Singleton<WeeklyStorageRegistryFactory>::get();
+}
+
+// static
+WeeklyStorageRegistry* WeeklyStorageRegistryFactory::GetForBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<WeeklyStorageRegistry*>(
+      WeeklyStorageRegistryFactory::GetInstance()
+          ->GetServiceForBrowserContext(context, true /*create*/));
+}
+
+WeeklyStorageRegistryFactory::WeeklyStorageRegistryFactory()
+    : BrowserContextKeyedServiceFactory(
+          "WeeklyStorageRegistry",
+          BrowserContextDependencyManager::GetInstance()) {}
+
+WeeklyStorageRegistryFactory::~WeeklyStorageRegistryFactory() = default;
+
+KeyedService* WeeklyStorageRegistryFactory::BuildServiceInstanceFor(
+    content::BrowserContext* context) const {
+  return new WeeklyStorageRegistry(user_prefs::UserPrefs::Get(context));
+}
+
+content::BrowserContext* WeeklyStorageRegistryFactory::GetBrowserContextToUse(
+    content::BrowserContext* context) const {
+  // Off the record contexts have prefs of their own
+  return context;
+}
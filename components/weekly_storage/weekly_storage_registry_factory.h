@@ -0,0 +1,37 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_FACTORY_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_FACTORY_H_
+
+#include "base/memory/singleton.h"
+#include "components/keyed_service/content/browser_context_keyed_service_factory.h"
+#include "components/keyed_service/core/keyed_service.h"
+
+class WeeklyStorageRegistry;
+
+class WeeklyStorageRegistryFactory : public BrowserContextKeyedServiceFactory {
+ public:
+  static WeeklyStorageRegistryFactory* GetInstance();
+  static WeeklyStorageRegistry* GetForBrowserContext(
+      content::BrowserContext* context);
+
+ private:
+  friend struct base::DefaultSingletonTraits<WeeklyStorageRegistryFactory>;
+  WeeklyStorageRegistryFactory();
+  ~WeeklyStorageRegistryFactory() override;
+
+  WeeklyStorageRegistryFactory(const WeeklyStorageRegistryFactory&) = delete;
+  WeeklyStorageRegistryFactory& operator=(const WeeklyStorageRegistryFactory&) =
+      delete;
+
+  // BrowserContextKeyedServiceFactory overrides:
+  KeyedService* BuildServiceInstanceFor(
+      content::BrowserContext* context) const override;
+  content::BrowserContext* GetBrowserContextToUse(
+      content::BrowserContext* context) const override;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_FACTORY_H_
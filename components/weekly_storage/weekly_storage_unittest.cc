@@ -6,10 +6,13 @@
 #include "brave/components/weekly_storage/weekly_storage.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -138,3 +141,70 @@ TEST_F(WeeklyStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetWeeklySum(), high_value + low_value);
 }
+
+class WeeklyStorageRegistryTest : public ::testing::Test {
+ public:
+  WeeklyStorageRegistryTest() {
+    pref_service_.registry()->RegisterListPref(kPrefName);
+  }
+
+ protected:
+  static constexpr char kPrefName[] = "brave.weekly_registry_test";
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple pref_service_;
+};
+
+constexpr char WeeklyStorageRegistryTest::kPrefName[];
+
+TEST_F(WeeklyStorageRegistryTest, SharesStoragePerPref) {
+  WeeklyStorageRegistry registry(&pref_service_);
+  WeeklyStorage* storage = registry.Get(kPrefName);
+  storage->AddDelta(10);
+
+  EXPECT_EQ(storage, registry.Get(kPrefName));
+  EXPECT_EQ(registry.Get(kPrefName)->GetWeeklySum(), 10ULL);
+}
+
+TEST_F(WeeklyStorageRegistryTest, DefersSaving) {
+  WeeklyStorageRegistry registry(&pref_service_);
+  registry.Get(kPrefName)->AddDelta(10);
+  registry.Get(kPrefName)->AddDelta(10);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName)->GetList().empty());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  WeeklyStorage loaded(&pref_service_, kPrefName);
+  EXPECT_EQ(loaded.GetWeeklySum(), 20ULL);
+}
+
+TEST_F(WeeklyStorageRegistryTest, SavesOnShutdown) {
+  WeeklyStorageRegistry registry(&pref_service_);
+  registry.Get(kPrefName)->AddDelta(10);
+  registry.Shutdown();
+
+  WeeklyStorage loaded(&pref_service_, kPrefName);
+  EXPECT_EQ(loaded.GetWeeklySum(), 10ULL);
+}
+
+TEST_F(WeeklyStorageRegistryTest, CopiesPrefName) {
+  WeeklyStorageRegistry registry(&pref_service_);
+  {
+    // The caller's name is gone by the time the storage saves
+    const std::string pref_name(kPrefName);
+    registry.Get(pref_name.c_str())->AddDelta(10);
+  }
+  {
+    const std::string pref_name(kPrefName);
+    EXPECT_EQ(registry.Get(pref_name.c_str())->GetWeeklySum(), 10ULL);
+  }
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromMinutes(1));
+  WeeklyStorage loaded(&pref_service_, kPrefName);
+  EXPECT_EQ(loaded.GetWeeklySum(), 10ULL);
+
+  registry.Get(std::string(kPrefName).c_str())->AddDelta(5);
+  registry.Shutdown();
+  WeeklyStorage reloaded(&pref_service_, kPrefName);
+  EXPECT_EQ(reloaded.GetWeeklySum(), 15ULL);
+}
@@ -0,0 +1,150 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling_helper.h"
+
+#include <algorithm>
+
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace brave {
+
+namespace {
+
+const uint64_t zero = 0;
+
+// Number of LFSR values generated before they are converted to samples.
+const size_t kSequenceBlockSize = 256;
+
+inline uint64_t lfsr_next(uint64_t v) {
+  return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
+}
+
+inline float SequenceValueToSample(uint64_t v) {
+  const double maxUInt64AsDouble = UINT64_MAX;
+  // pseudo-random float between 0 and 0.1
+  return (v / maxUInt64AsDouble) / 10;
+}
+
+// The products are computed in double precision and rounded back to float, so
+// the vector paths produce exactly the same samples as the scalar one.
+void MultiplyByConstant(float* data, size_t size, double fudge_factor) {
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  const __m128d factor = _mm_set1_pd(fudge_factor);
+  for (; i + 4 <= size; i += 4) {
+    const __m128 samples = _mm_loadu_ps(data + i);
+    const __m128d low = _mm_mul_pd(_mm_cvtps_pd(samples), factor);
+    const __m128d high =
+        _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(samples, samples)), factor);
+    _mm_storeu_ps(data + i,
+                  _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)));
+  }
+#elif defined(ARCH_CPU_ARM64)
+  for (; i + 4 <= size; i += 4) {
+    const float32x4_t samples = vld1q_f32(data + i);
+    const float64x2_t low =
+        vmulq_n_f64(vcvt_f64_f32(vget_low_f32(samples)), fudge_factor);
+    const float64x2_t high =
+        vmulq_n_f64(vcvt_high_f64_f32(samples), fudge_factor);
+    vst1q_f32(data + i, vcombine_f32(vcvt_f32_f64(low), vcvt_f32_f64(high)));
+  }
+#endif
+  for (; i < size; i++) {
+    data[i] = data[i] * fudge_factor;
+  }
+}
+
+void FillPseudoRandomSequence(float* data, size_t size, uint64_t seed) {
+  uint64_t values[kSequenceBlockSize];
+  uint64_t v = seed;
+  for (size_t offset = 0; offset < size; offset += kSequenceBlockSize) {
+    const size_t count = std::min(kSequenceBlockSize, size - offset);
+    // The LFSR itself is serial, so generate a block of values first and
+    // convert them in a separate loop the compiler can vectorize.
+    for (size_t i = 0; i < count; i++) {
+      v = lfsr_next(v);
+      values[i] = v;
+    }
+    float* destination = data + offset;
+    for (size_t i = 0; i < count; i++) {
+      destination[i] = SequenceValueToSample(values[i]);
+    }
+  }
+}
+
+}  // namespace
+
+AudioFarblingHelper::AudioFarblingHelper()
+    : AudioFarblingHelper(Mode::kIdentity, 1.0, 0) {}
+
+AudioFarblingHelper::AudioFarblingHelper(Mode mode,
+                                         double fudge_factor,
+                                         uint64_t seed)
+    : mode_(mode), fudge_factor_(fudge_factor), seed_(seed) {}
+
+AudioFarblingHelper::AudioFarblingHelper(const AudioFarblingHelper&) = default;
+
+AudioFarblingHelper& AudioFarblingHelper::operator=(
+    const AudioFarblingHelper&) = default;
+
+AudioFarblingHelper::~AudioFarblingHelper() = default;
+
+// static
+AudioFarblingHelper AudioFarblingHelper::ConstantMultiplier(
+    double fudge_factor) {
+  return AudioFarblingHelper(Mode::kConstantMultiplier, fudge_factor, 0);
+}
+
+// static
+AudioFarblingHelper AudioFarblingHelper::PseudoRandomSequence(uint64_t seed) {
+  return AudioFarblingHelper(Mode::kPseudoRandomSequence, 1.0, seed);
+}
+
+void AudioFarblingHelper::FarbleAudio(base::span<float> data) const {
+  if (data.empty())
+    return;
+
+  switch (mode_) {
+    case Mode::kIdentity:
+      break;
+    case Mode::kConstantMultiplier:
+      MultiplyByConstant(data.data(), data.size(), fudge_factor_);
+      break;
+    case Mode::kPseudoRandomSequence:
+      FillPseudoRandomSequence(data.data(), data.size(), seed_);
+      break;
+  }
+}
+
+float AudioFarblingHelper::FarbleAudioSample(float value,
+                                             size_t index,
+                                             uint64_t* state) const {
+  switch (mode_) {
+    case Mode::kIdentity:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandomSequence: {
+      if (index == 0) {
+        // start of loop, reset to initial seed which is based on the domain
+        // key
+        *state = seed_;
+      }
+      // get next value in PRNG sequence
+      *state = lfsr_next(*state);
+      return SequenceValueToSample(*state);
+    }
+  }
+  return value;
+}
+
+}  // namespace brave
@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_HELPER_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_HELPER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/containers/span.h"
+
+namespace brave {
+
+// Farbles Web Audio sample data. Copyable and immutable, so one helper can be
+// shared by the main thread and audio worklet threads. Any pseudo-random
+// sequence state lives with the caller.
+class AudioFarblingHelper {
+ public:
+  // Leaves samples untouched.
+  AudioFarblingHelper();
+
+  // Multiplies every sample by |fudge_factor| (balanced farbling).
+  static AudioFarblingHelper ConstantMultiplier(double fudge_factor);
+
+  // Replaces sample i with the (i + 1)th value of the LFSR sequence seeded
+  // with |seed|, scaled to [0, 0.1) (maximum farbling).
+  static AudioFarblingHelper PseudoRandomSequence(uint64_t seed);
+
+  AudioFarblingHelper(const AudioFarblingHelper&);
+  AudioFarblingHelper& operator=(const AudioFarblingHelper&);
+  ~AudioFarblingHelper();
+
+  bool IsIdentity() const { return mode_ == Mode::kIdentity; }
+
+  // Farbles |data| in place, treating data[0] as sample 0.
+  void FarbleAudio(base::span<float> data) const;
+
+  // Farbles a single |value| for callers that farble intermediate values
+  // sample by sample. Must be called with consecutive |index| values starting
+  // at 0, which resets |state|.
+  float FarbleAudioSample(float value, size_t index, uint64_t* state) const;
+
+ private:
+  enum class Mode {
+    kIdentity,
+    kConstantMultiplier,
+    kPseudoRandomSequence,
+  };
+
+  AudioFarblingHelper(Mode mode, double fudge_factor, uint64_t seed);
+
+  Mode mode_;
+  double fudge_factor_;
+  uint64_t seed_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_AUDIO_FARBLING_HELPER_H_
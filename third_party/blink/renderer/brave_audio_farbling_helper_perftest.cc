@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/timer/elapsed_timer.h"
+#include "brave/third_party/blink/renderer/brave_audio_farbling_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_farbling_perftests --filter=AudioFarblingHelperPerfTest.*
+
+namespace brave {
+
+namespace {
+
+// getChannelData() farbles the whole channel, so measure a 10 minute buffer
+const size_t kSampleRate = 48000;
+const size_t kBufferSeconds = 10 * 60;
+
+constexpr char kMetricPrefix[] = "AudioFarbling.";
+constexpr char kMetricThroughput[] = "throughput";
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricThroughput, "Msamples/s");
+  return reporter;
+}
+
+void RunGetChannelData(const std::string& story,
+                       const AudioFarblingHelper& helper) {
+  std::vector<float> channel(kSampleRate * kBufferSeconds);
+  for (size_t i = 0; i < channel.size(); i++) {
+    channel[i] = static_cast<float>(i % kSampleRate) / kSampleRate;
+  }
+
+  base::ElapsedTimer timer;
+  helper.FarbleAudio(channel);
+  const base::TimeDelta elapsed = timer.Elapsed();
+
+  SetUpReporter(story).AddResult(
+      kMetricThroughput, channel.size() / 1e6 / elapsed.InSecondsF());
+}
+
+}  // namespace
+
+TEST(AudioFarblingHelperPerfTest, GetChannelDataBalanced) {
+  RunGetChannelData("balanced",
+                    AudioFarblingHelper::ConstantMultiplier(0.99537));
+}
+
+TEST(AudioFarblingHelperPerfTest, GetChannelDataMaximum) {
+  RunGetChannelData("maximum",
+                    AudioFarblingHelper::PseudoRandomSequence(
+                        0x0123456789abcdef));
+}
+
+}  // namespace brave
@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_audio_farbling_helper.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=AudioFarblingHelperTest.*
+
+namespace brave {
+
+namespace {
+
+const uint64_t kSeed = 0x0123456789abcdef;
+const double kFudgeFactor = 0.99537;
+
+// Odd length so the vector paths also leave a scalar tail.
+const size_t kSampleCount = 1027;
+
+std::vector<float> MakeSamples() {
+  std::vector<float> samples(kSampleCount);
+  for (size_t i = 0; i < samples.size(); i++) {
+    samples[i] = (static_cast<float>(i % 200) - 100.f) / 97.f;
+  }
+  return samples;
+}
+
+// Per-sample implementations the span based kernels replaced
+float ReferenceConstantMultiplier(double fudge_factor, float value) {
+  return value * fudge_factor;
+}
+
+float ReferencePseudoRandomSequence(uint64_t* v) {
+  const uint64_t zero = 0;
+  const double maxUInt64AsDouble = UINT64_MAX;
+  *v = ((*v >> 1) | (((*v << 62) ^ (*v << 61)) & (~(~zero << 63) << 62)));
+  return (*v / maxUInt64AsDouble) / 10;
+}
+
+}  // namespace
+
+TEST(AudioFarblingHelperTest, IdentityLeavesSamplesUntouched) {
+  const AudioFarblingHelper helper;
+  EXPECT_TRUE(helper.IsIdentity());
+
+  std::vector<float> samples = MakeSamples();
+  helper.FarbleAudio(samples);
+  EXPECT_EQ(MakeSamples(), samples);
+}
+
+TEST(AudioFarblingHelperTest, ConstantMultiplierMatchesPerSampleResult) {
+  const AudioFarblingHelper helper =
+      AudioFarblingHelper::ConstantMultiplier(kFudgeFactor);
+  EXPECT_FALSE(helper.IsIdentity());
+
+  const std::vector<float> original = MakeSamples();
+  std::vector<float> samples = original;
+  helper.FarbleAudio(samples);
+
+  uint64_t state = 0;
+  for (size_t i = 0; i < samples.size(); i++) {
+    const float expected = ReferenceConstantMultiplier(kFudgeFactor,
+                                                       original[i]);
+    EXPECT_EQ(expected, samples[i]) << "sample " << i;
+    EXPECT_EQ(expected, helper.FarbleAudioSample(original[i], i, &state));
+  }
+}
+
+TEST(AudioFarblingHelperTest, PseudoRandomSequenceMatchesPerSampleResult) {
+  const AudioFarblingHelper helper =
+      AudioFarblingHelper::PseudoRandomSequence(kSeed);
+
+  std::vector<float> samples = MakeSamples();
+  helper.FarbleAudio(samples);
+
+  uint64_t reference_state = kSeed;
+  uint64_t state = 0;
+  for (size_t i = 0; i < samples.size(); i++) {
+    const float expected = ReferencePseudoRandomSequence(&reference_state);
+    EXPECT_EQ(expected, samples[i]) << "sample " << i;
+    EXPECT_EQ(expected, helper.FarbleAudioSample(0.5f, i, &state));
+  }
+}
+
+TEST(AudioFarblingHelperTest, PseudoRandomSequenceRestartsForEachCall) {
+  const AudioFarblingHelper helper =
+      AudioFarblingHelper::PseudoRandomSequence(kSeed);
+
+  std::vector<float> first(kSampleCount);
+  helper.FarbleAudio(first);
+  std::vector<float> second(kSampleCount / 2);
+  helper.FarbleAudio(second);
+
+  EXPECT_TRUE(std::equal(second.begin(), second.end(), first.begin()));
+}
+
+}  // namespace brave
@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
+
+#include <string.h>
+
+#include "base/check.h"
+#include "base/strings/string_piece.h"
+#include "crypto/hmac.h"
+
+namespace brave {
+
+namespace {
+
+const uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+const uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+const uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+
+const size_t kStripeSize = 32;
+
+inline uint64_t RotateLeft(uint64_t v, int bits) {
+  return (v << bits) | (v >> (64 - bits));
+}
+
+inline uint64_t Read64(const uint8_t* data) {
+  uint64_t v;
+  memcpy(&v, data, sizeof(v));
+  return v;
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input) {
+  acc += input * kPrime2;
+  acc = RotateLeft(acc, 31);
+  return acc * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t lane) {
+  acc ^= Round(0, lane);
+  return acc * kPrime1 + kPrime4;
+}
+
+}  // namespace
+
+uint64_t CanvasContentDigest(base::span<const uint8_t> data, uint64_t key) {
+  const uint8_t* p = data.data();
+  size_t remaining = data.size();
+
+  uint64_t digest;
+  if (remaining >= kStripeSize) {
+    uint64_t lanes[4] = {key + kPrime1 + kPrime2, key + kPrime2, key,
+                         key - kPrime1};
+    for (; remaining >= kStripeSize; remaining -= kStripeSize) {
+      for (int i = 0; i < 4; i++)
+        lanes[i] = Round(lanes[i], Read64(p + i * 8));
+      p += kStripeSize;
+    }
+    digest = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) +
+             RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+    for (int i = 0; i < 4; i++)
+      digest = MergeRound(digest, lanes[i]);
+  } else {
+    digest = key + kPrime3;
+  }
+
+  digest += data.size();
+
+  for (; remaining >= 8; remaining -= 8, p += 8)
+    digest = RotateLeft(digest ^ Round(0, Read64(p)), 27) * kPrime1 + kPrime4;
+  for (; remaining > 0; remaining--, p++)
+    digest = RotateLeft(digest ^ (*p * kPrime3), 11) * kPrime1;
+
+  digest ^= digest >> 33;
+  digest *= kPrime2;
+  digest ^= digest >> 29;
+  digest *= kPrime3;
+  digest ^= digest >> 32;
+  return digest;
+}
+
+CanvasFarblingKey MakeCanvasFarblingKey(uint64_t session_plus_domain_key,
+                                        base::span<const uint8_t> pixels) {
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
+               sizeof session_plus_domain_key));
+
+  CanvasFarblingKey canvas_key;
+  if (pixels.size() <= kMaxCanvasSizeForFullHmac) {
+    CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels.data()),
+                                   pixels.size()),
+                 canvas_key.data(), canvas_key.size()));
+    return canvas_key;
+  }
+
+  // Hashing tens of megabytes with SHA-256 on every readback is too slow, so
+  // only the keyed digest and the size go through the HMAC. The digest is
+  // keyed as well, so colliding canvases can't be crafted without the key.
+  const uint64_t message[2] = {
+      CanvasContentDigest(pixels, session_plus_domain_key),
+      static_cast<uint64_t>(pixels.size())};
+  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(message),
+                                 sizeof message),
+               canvas_key.data(), canvas_key.size()));
+  return canvas_key;
+}
+
+}  // namespace brave
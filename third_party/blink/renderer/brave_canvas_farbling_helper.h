@@ -0,0 +1,35 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_HELPER_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_HELPER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+#include "base/containers/span.h"
+
+namespace brave {
+
+// Canvases up to this many bytes (128x128 RGBA) are keyed by an HMAC over
+// their pixels. Larger ones are reduced to a keyed digest first.
+const size_t kMaxCanvasSizeForFullHmac = 64 * 1024;
+
+using CanvasFarblingKey = std::array<uint8_t, 32>;
+
+// Keyed 64-bit digest of |data|. Processes 32 byte stripes in four
+// independent lanes so it runs at memory speed on large canvases.
+uint64_t CanvasContentDigest(base::span<const uint8_t> data, uint64_t key);
+
+// Returns the key which decides how the canvas |pixels| are perturbed. It is
+// deterministic for a given |session_plus_domain_key| and canvas content.
+CanvasFarblingKey MakeCanvasFarblingKey(uint64_t session_plus_domain_key,
+                                        base::span<const uint8_t> pixels);
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_BRAVE_CANVAS_FARBLING_HELPER_H_
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
+#include "crypto/hmac.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_farbling_perftests --filter=CanvasFarblingHelperPerfTest.*
+
+namespace brave {
+
+namespace {
+
+const int kCanvasSizes[] = {16, 128, 512, 1024, 2048, 4096};
+const int kIterations = 10;
+const uint64_t kKey = 0x0123456789abcdef;
+
+constexpr char kMetricPrefix[] = "CanvasFarbling.";
+constexpr char kMetricHmacThroughput[] = "hmac_throughput";
+constexpr char kMetricKeyThroughput[] = "key_throughput";
+
+perf_test::PerfResultReporter SetUpReporter(const int canvas_size) {
+  const std::string size = base::NumberToString(canvas_size);
+  perf_test::PerfResultReporter reporter(kMetricPrefix,
+                                         "canvas_" + size + "x" + size);
+  reporter.RegisterImportantMetric(kMetricHmacThroughput, "MB/s");
+  reporter.RegisterImportantMetric(kMetricKeyThroughput, "MB/s");
+  return reporter;
+}
+
+double GetMegabytesPerSecond(const size_t bytes,
+                             const base::TimeDelta elapsed) {
+  return bytes / 1e6 / elapsed.InSecondsF();
+}
+
+// The previous scheme, which signed every pixel with HMAC-SHA256
+void SignPixels(const std::vector<uint8_t>& pixels) {
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  ASSERT_TRUE(
+      h.Init(reinterpret_cast<const unsigned char*>(&kKey), sizeof kKey));
+  CanvasFarblingKey canvas_key;
+  ASSERT_TRUE(h.Sign(
+      base::StringPiece(reinterpret_cast<const char*>(pixels.data()),
+                        pixels.size()),
+      canvas_key.data(), canvas_key.size()));
+}
+
+}  // namespace
+
+TEST(CanvasFarblingHelperPerfTest, MakeCanvasFarblingKey) {
+  for (const int canvas_size : kCanvasSizes) {
+    std::vector<uint8_t> pixels(canvas_size * canvas_size * 4);
+    for (size_t i = 0; i < pixels.size(); i++) {
+      pixels[i] = static_cast<uint8_t>(i);
+    }
+    const size_t bytes = pixels.size() * kIterations;
+    perf_test::PerfResultReporter reporter = SetUpReporter(canvas_size);
+
+    base::ElapsedTimer hmac_timer;
+    for (int i = 0; i < kIterations; i++) {
+      SignPixels(pixels);
+    }
+    reporter.AddResult(kMetricHmacThroughput,
+                       GetMegabytesPerSecond(bytes, hmac_timer.Elapsed()));
+
+    base::ElapsedTimer key_timer;
+    for (int i = 0; i < kIterations; i++) {
+      MakeCanvasFarblingKey(kKey, pixels);
+    }
+    reporter.AddResult(kMetricKeyThroughput,
+                       GetMegabytesPerSecond(bytes, key_timer.Elapsed()));
+  }
+}
+
+}  // namespace brave
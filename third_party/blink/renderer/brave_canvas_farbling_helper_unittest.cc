@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/brave_canvas_farbling_helper.h"
+
+#include <vector>
+
+#include "base/strings/string_piece.h"
+#include "crypto/hmac.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=CanvasFarblingHelperTest.*
+
+namespace brave {
+
+namespace {
+
+const uint64_t kKey = 0x0123456789abcdef;
+
+std::vector<uint8_t> MakePixels(size_t size) {
+  std::vector<uint8_t> pixels(size);
+  for (size_t i = 0; i < pixels.size(); i++) {
+    pixels[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  return pixels;
+}
+
+}  // namespace
+
+TEST(CanvasFarblingHelperTest, SmallCanvasKeyIsHmacOfPixels) {
+  const std::vector<uint8_t> pixels = MakePixels(16 * 16 * 4);
+
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  ASSERT_TRUE(
+      h.Init(reinterpret_cast<const unsigned char*>(&kKey), sizeof kKey));
+  CanvasFarblingKey expected;
+  ASSERT_TRUE(h.Sign(
+      base::StringPiece(reinterpret_cast<const char*>(pixels.data()),
+                        pixels.size()),
+      expected.data(), expected.size()));
+
+  EXPECT_EQ(expected, MakeCanvasFarblingKey(kKey, pixels));
+}
+
+TEST(CanvasFarblingHelperTest, LargeCanvasKeyIsDeterministic) {
+  std::vector<uint8_t> pixels = MakePixels(kMaxCanvasSizeForFullHmac * 4 + 3);
+  const CanvasFarblingKey canvas_key = MakeCanvasFarblingKey(kKey, pixels);
+
+  EXPECT_EQ(canvas_key, MakeCanvasFarblingKey(kKey, pixels));
+  EXPECT_NE(canvas_key, MakeCanvasFarblingKey(kKey + 1, pixels));
+
+  pixels[pixels.size() / 2] ^= 1;
+  EXPECT_NE(canvas_key, MakeCanvasFarblingKey(kKey, pixels));
+}
+
+TEST(CanvasFarblingHelperTest, ContentDigestCoversEveryByte) {
+  // Sizes around the stripe boundary exercise both tail loops
+  for (const size_t size : {0u, 1u, 7u, 8u, 31u, 32u, 33u, 100u, 4099u}) {
+    std::vector<uint8_t> pixels = MakePixels(size);
+    const uint64_t digest = CanvasContentDigest(pixels, kKey);
+    EXPECT_EQ(digest, CanvasContentDigest(pixels, kKey));
+    EXPECT_NE(digest, CanvasContentDigest(pixels, kKey + 1));
+
+    for (size_t i = 0; i < size; i++) {
+      pixels[i] ^= 0x80;
+      EXPECT_NE(digest, CanvasContentDigest(pixels, kKey))
+          << "size " << size << " byte " << i;
+      pixels[i] ^= 0x80;
+    }
+  }
+}
+
+TEST(CanvasFarblingHelperTest, ContentDigestDependsOnSize) {
+  const std::vector<uint8_t> pixels(64, 0);
+  EXPECT_NE(CanvasContentDigest(base::make_span(pixels.data(), 32), kKey),
+            CanvasContentDigest(pixels, kKey));
+}
+
+}  // namespace brave
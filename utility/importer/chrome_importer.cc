@@ -5,6 +5,7 @@
 
 #include "brave/utility/importer/chrome_importer.h"
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,6 +16,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/post_job.h"
 #include "base/values.h"
 #include "build/build_config.h"
 #include "brave/common/importer/scoped_copy_file.h"
@@ -174,8 +176,45 @@ bool PasswordFormToImportedPasswordForm(
   return true;
 }
 
+void ReencodeFavicons(std::vector<ChromeImporter::PendingFavicon>* favicons,
+                      std::atomic<size_t>* next_index,
+                      base::JobDelegate* delegate) {
+  while (!delegate->ShouldYield()) {
+    const size_t index = next_index->fetch_add(1);
+    if (index >= favicons->size())
+      return;
+
+    ChromeImporter::PendingFavicon& favicon = (*favicons)[index];
+    favicon.reencoded = importer::ReencodeFavicon(
+        &favicon.data[0], favicon.data.size(), &favicon.usage.png_data);
+    favicon.data.clear();
+  }
+}
+
+size_t GetReencodeConcurrency(const std::atomic<size_t>* next_index,
+                              size_t total,
+                              size_t worker_count) {
+  const size_t next = next_index->load();
+  return next >= total ? 0 : total - next;
+}
+
 }  // namespace
 
+// static
+constexpr size_t ChromeImporter::kHistoryBatchSize;
+// static
+constexpr size_t ChromeImporter::kFaviconBatchSize;
+
+ChromeImporter::PendingFavicon::PendingFavicon() = default;
+
+ChromeImporter::PendingFavicon::PendingFavicon(PendingFavicon&& other) =
+    default;
+
+ChromeImporter::PendingFavicon& ChromeImporter::PendingFavicon::operator=(
+    PendingFavicon&& other) = default;
+
+ChromeImporter::PendingFavicon::~PendingFavicon() = default;
+
 ChromeImporter::ChromeImporter() {
 }
 
@@ -250,6 +289,7 @@ void ChromeImporter::ImportHistory() {
   s.BindInt64(4, ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 
   std::vector<ImporterURLRow> rows;
+  rows.reserve(kHistoryBatchSize);
   while (s.Step() && !cancelled()) {
     GURL url(s.ColumnString(0));
 
@@ -262,6 +302,13 @@ void ChromeImporter::ImportHistory() {
     row.visit_count = s.ColumnInt(4);
 
     rows.push_back(row);
+
+    // Hand rows over in bounded batches rather than holding every visit of a
+    // large profile in memory until the query is done.
+    if (rows.size() == kHistoryBatchSize) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -281,6 +328,8 @@ void ChromeImporter::ImportBookmarks() {
                          &bookmarks_content);
   base::Optional<base::Value> bookmarks_json =
     base::JSONReader::Read(bookmarks_content);
+  // The parsed tree is all that's needed from here on.
+  bookmarks_content = std::string();
   const base::DictionaryValue* bookmark_dict;
   if (!bookmarks_json || !bookmarks_json->GetAsDictionary(&bookmark_dict))
     return;
@@ -308,7 +357,11 @@ void ChromeImporter::ImportBookmarks() {
       RecursiveReadBookmarksFolder(other, path, false, &bookmarks);
     }
   }
-  // Write into profile.
+  // Release the parsed tree before the favicons are loaded.
+  bookmarks_json.reset();
+
+  // Write into profile. Bookmarks are sent in one go since every
+  // AddBookmarks() call creates its own "Imported from Chrome" folder.
   if (!bookmarks.empty() && !cancelled()) {
     const base::string16& first_folder_name =
       base::UTF8ToUTF16("Imported from Chrome");
@@ -333,11 +386,8 @@ void ChromeImporter::ImportBookmarks() {
   FaviconMap favicon_map;
   ImportFaviconURLs(&db, &favicon_map);
   // Write favicons into profile.
-  if (!favicon_map.empty() && !cancelled()) {
-    favicon_base::FaviconUsageDataList favicons;
-    LoadFaviconData(&db, favicon_map, &favicons);
-    bridge_->SetFavicons(favicons);
-  }
+  if (!favicon_map.empty() && !cancelled())
+    LoadFaviconData(&db, favicon_map);
 }
 
 void ChromeImporter::ImportFaviconURLs(
@@ -355,8 +405,7 @@ void ChromeImporter::ImportFaviconURLs(
 
 void ChromeImporter::LoadFaviconData(
     sql::Database* db,
-    const FaviconMap& favicon_map,
-    favicon_base::FaviconUsageDataList* favicons) {
+    const FaviconMap& favicon_map) {
   const char query[] = "SELECT f.url, fb.image_data "
                        "FROM favicons f "
                        "JOIN favicon_bitmaps fb "
@@ -367,29 +416,57 @@ void ChromeImporter::LoadFaviconData(
   if (!s.is_valid())
     return;
 
+  std::vector<PendingFavicon> pending;
+  pending.reserve(kFaviconBatchSize);
   for (FaviconMap::const_iterator i = favicon_map.begin();
-       i != favicon_map.end(); ++i) {
+       i != favicon_map.end() && !cancelled(); ++i) {
     s.BindInt64(0, i->first);
     if (s.Step()) {
-      favicon_base::FaviconUsageData usage;
-
-      usage.favicon_url = GURL(s.ColumnString(0));
-      if (!usage.favicon_url.is_valid())
-        continue;  // Don't bother importing favicons with invalid URLs.
+      PendingFavicon favicon;
+
+      favicon.usage.favicon_url = GURL(s.ColumnString(0));
+      s.ColumnBlobAsVector(1, &favicon.data);
+      // Don't bother importing favicons with invalid URLs. Empty data is
+      // definitely invalid.
+      if (favicon.usage.favicon_url.is_valid() && !favicon.data.empty()) {
+        favicon.usage.urls = i->second;
+        pending.push_back(std::move(favicon));
+      }
+    }
+    s.Reset(true);
 
-      std::vector<unsigned char> data;
-      s.ColumnBlobAsVector(1, &data);
-      if (data.empty())
-        continue;  // Data definitely invalid.
+    if (pending.size() == kFaviconBatchSize) {
+      SendFavicons(&pending);
+      pending.clear();
+    }
+  }
 
-      if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
-        continue;  // Unable to decode.
+  if (!pending.empty() && !cancelled())
+    SendFavicons(&pending);
+}
 
-      usage.urls = i->second;
-      favicons->push_back(usage);
-    }
-    s.Reset(true);
+void ChromeImporter::SendFavicons(std::vector<PendingFavicon>* pending) {
+  // Decoding and reencoding dominates favicon import, so spread it across
+  // the thread pool and help out from this thread until the batch is done.
+  std::atomic<size_t> next_index(0);
+  base::PostJob(
+      FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+      base::BindRepeating(&ReencodeFavicons, base::Unretained(pending),
+                          base::Unretained(&next_index)),
+      base::BindRepeating(&GetReencodeConcurrency,
+                          base::Unretained(&next_index), pending->size()))
+      .Join();
+
+  favicon_base::FaviconUsageDataList favicons;
+  favicons.reserve(pending->size());
+  for (auto& favicon : *pending) {
+    if (favicon.reencoded)
+      favicons.push_back(std::move(favicon.usage));
+    // Otherwise unable to decode.
   }
+
+  if (!favicons.empty() && !cancelled())
+    bridge_->SetFavicons(favicons);
 }
 
 void ChromeImporter::RecursiveReadBookmarksFolder(
@@ -6,6 +6,7 @@
 #ifndef BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_H_
 #define BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <map>
@@ -32,6 +33,23 @@ class Database;
 
 class ChromeImporter : public Importer {
  public:
+  // History rows and favicons are sent to the bridge in batches of at most
+  // this many items.
+  static constexpr size_t kHistoryBatchSize = 1000;
+  static constexpr size_t kFaviconBatchSize = 100;
+
+  // A favicon read from the profile which is waiting to be reencoded.
+  struct PendingFavicon {
+    PendingFavicon();
+    PendingFavicon(PendingFavicon&& other);
+    PendingFavicon& operator=(PendingFavicon&& other);
+    ~PendingFavicon();
+
+    favicon_base::FaviconUsageData usage;
+    std::vector<unsigned char> data;
+    bool reencoded = false;
+  };
+
   ChromeImporter();
 
   // Importer:
@@ -62,10 +80,12 @@ class ChromeImporter : public Importer {
     sql::Database* db,
     FaviconMap* favicon_map);
 
-  // Loads and reencodes the individual favicons.
-  void LoadFaviconData(sql::Database* db,
-                       const FaviconMap& favicon_map,
-                       favicon_base::FaviconUsageDataList* favicons);
+  // Loads the individual favicons and sends them to the bridge in batches.
+  void LoadFaviconData(sql::Database* db, const FaviconMap& favicon_map);
+
+  // Reencodes |pending| in parallel and sends the ones which could be decoded
+  // to the bridge.
+  void SendFavicons(std::vector<PendingFavicon>* pending);
 
   void RecursiveReadBookmarksFolder(
     const base::DictionaryValue* folder,
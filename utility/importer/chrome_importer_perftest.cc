@@ -0,0 +1,130 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/process/process_metrics.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "brave/utility/importer/chrome_importer.h"
+#include "brave/utility/importer/chrome_importer_test_util.h"
+#include "chrome/common/importer/importer_data_types.h"
+#include "chrome/common/importer/importer_url_row.h"
+#include "chrome/common/importer/mock_importer_bridge.h"
+#include "components/favicon_base/favicon_usage_data.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// npm run test -- brave_importer_perftests --filter=ChromeImporterPerfTest.*
+
+using ::testing::_;
+
+namespace {
+
+const int kVisitCount = 100000;
+const int kIconCount = 5000;
+
+constexpr char kMetricPrefix[] = "ChromeImporter.";
+constexpr char kMetricImportTime[] = "import_time";
+constexpr char kMetricPeakMallocGrowth[] = "peak_malloc_growth";
+constexpr char kMetricBatches[] = "batches";
+
+size_t GetMallocUsage() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()->GetMallocUsage();
+}
+
+}  // namespace
+
+// Imports synthetic profiles large enough for batching to matter. The heap is
+// sampled each time a batch is handed to the bridge, which is when the
+// importer holds the most items, so the reported peak growth reflects what the
+// batch sizes cap rather than the size of the profile.
+class ChromeImporterPerfTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    profile_.source_path = temp_dir_.GetPath();
+    importer_ = base::MakeRefCounted<ChromeImporter>();
+    bridge_ = base::MakeRefCounted<::testing::NiceMock<MockImporterBridge>>();
+
+    ON_CALL(*bridge_, SetHistoryItems(_, _))
+        .WillByDefault([this](const std::vector<ImporterURLRow>& rows,
+                              importer::VisitSource visit_source) {
+          OnBatch(rows.size());
+        });
+    ON_CALL(*bridge_, SetFavicons(_))
+        .WillByDefault(
+            [this](const favicon_base::FaviconUsageDataList& favicons) {
+              OnBatch(favicons.size());
+            });
+  }
+
+  void RunImport(const std::string& story,
+                 uint16_t items,
+                 size_t expected_count) {
+    malloc_usage_ = GetMallocUsage();
+    const base::TimeTicks start = base::TimeTicks::Now();
+    importer_->StartImport(profile_, items, bridge_.get());
+    const base::TimeDelta import_time = base::TimeTicks::Now() - start;
+
+    EXPECT_EQ(expected_count, imported_count_);
+
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricImportTime, "ms");
+    reporter.RegisterImportantMetric(kMetricPeakMallocGrowth, "bytes");
+    reporter.RegisterFyiMetric(kMetricBatches, "count");
+    reporter.AddResult(kMetricImportTime, import_time);
+    reporter.AddResult(kMetricPeakMallocGrowth, peak_malloc_growth_);
+    reporter.AddResult(kMetricBatches, batches_);
+  }
+
+  base::FilePath GetProfileFile(const char* name) const {
+    return profile_.source_path.AppendASCII(name);
+  }
+
+ private:
+  void OnBatch(size_t count) {
+    imported_count_ += count;
+    batches_++;
+
+    const size_t malloc_usage = GetMallocUsage();
+    if (malloc_usage > malloc_usage_) {
+      peak_malloc_growth_ =
+          std::max(peak_malloc_growth_, malloc_usage - malloc_usage_);
+    }
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  importer::SourceProfile profile_;
+  scoped_refptr<ChromeImporter> importer_;
+  scoped_refptr<::testing::NiceMock<MockImporterBridge>> bridge_;
+
+  size_t malloc_usage_ = 0;
+  size_t peak_malloc_growth_ = 0;
+  size_t imported_count_ = 0;
+  size_t batches_ = 0;
+};
+
+TEST_F(ChromeImporterPerfTest, History) {
+  ASSERT_TRUE(
+      CreateChromeHistoryDatabase(GetProfileFile("History"), kVisitCount));
+  RunImport("history", importer::HISTORY, kVisitCount);
+}
+
+TEST_F(ChromeImporterPerfTest, Favicons) {
+  // Favicons are imported along with bookmarks, which need a Bookmarks file
+  ASSERT_TRUE(base::WriteFile(GetProfileFile("Bookmarks"), "{\"roots\": {}}"));
+  ASSERT_TRUE(
+      CreateChromeFaviconsDatabase(GetProfileFile("Favicons"), kIconCount));
+  RunImport("favicons", importer::FAVORITES, kIconCount);
+}
@@ -0,0 +1,137 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/utility/importer/chrome_importer_test_util.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/strings/stringprintf.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/base/page_transition_types.h"
+#include "ui/gfx/codec/png_codec.h"
+
+namespace {
+
+// September 2020 in Chrome's microseconds since 1601
+constexpr int64_t kVisitTime = 13245000000000000;
+
+constexpr int kFaviconSize = 16;
+
+}  // namespace
+
+bool CreateChromeHistoryDatabase(const base::FilePath& path,
+                                 int visit_count) {
+  sql::Database db;
+  if (!db.Open(path))
+    return false;
+
+  if (!db.Execute(
+          "CREATE TABLE urls(id INTEGER PRIMARY KEY, url LONGVARCHAR, "
+          "title LONGVARCHAR, visit_count INTEGER DEFAULT 0 NOT NULL, "
+          "typed_count INTEGER DEFAULT 0 NOT NULL, "
+          "hidden INTEGER DEFAULT 0 NOT NULL)") ||
+      !db.Execute(
+          "CREATE TABLE visits(id INTEGER PRIMARY KEY, url INTEGER NOT NULL, "
+          "visit_time INTEGER NOT NULL, "
+          "transition INTEGER DEFAULT 0 NOT NULL)")) {
+    return false;
+  }
+
+  if (!db.BeginTransaction())
+    return false;
+
+  sql::Statement url(db.GetUniqueStatement(
+      "INSERT INTO urls (id, url, title, visit_count) VALUES (?, ?, ?, 1)"));
+  sql::Statement visit(db.GetUniqueStatement(
+      "INSERT INTO visits (url, visit_time, transition) VALUES (?, ?, ?)"));
+  for (int i = 0; i < visit_count; i++) {
+    url.BindInt64(0, i + 1);
+    url.BindString(1, base::StringPrintf("https://example%d.com/", i));
+    url.BindString(2, base::StringPrintf("Example %d", i));
+    if (!url.Run())
+      return false;
+    url.Reset(true);
+
+    visit.BindInt64(0, i + 1);
+    visit.BindInt64(1, kVisitTime + i);
+    visit.BindInt64(2,
+                    ui::PAGE_TRANSITION_LINK | ui::PAGE_TRANSITION_CHAIN_END);
+    if (!visit.Run())
+      return false;
+    visit.Reset(true);
+  }
+
+  return db.CommitTransaction();
+}
+
+bool CreateChromeFaviconsDatabase(const base::FilePath& path,
+                                  int icon_count) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kFaviconSize, kFaviconSize);
+  bitmap.eraseColor(SK_ColorBLUE);
+  std::vector<unsigned char> png_data;
+  if (!gfx::PNGCodec::EncodeBGRASkBitmap(bitmap, false, &png_data))
+    return false;
+
+  sql::Database db;
+  if (!db.Open(path))
+    return false;
+
+  if (!db.Execute(
+          "CREATE TABLE icon_mapping(id INTEGER PRIMARY KEY, "
+          "page_url LONGVARCHAR NOT NULL, icon_id INTEGER)") ||
+      !db.Execute(
+          "CREATE TABLE favicons(id INTEGER PRIMARY KEY, "
+          "url LONGVARCHAR NOT NULL, icon_type INTEGER DEFAULT 1)") ||
+      !db.Execute(
+          "CREATE TABLE favicon_bitmaps(id INTEGER PRIMARY KEY, "
+          "icon_id INTEGER NOT NULL, last_updated INTEGER DEFAULT 0, "
+          "image_data BLOB, width INTEGER DEFAULT 0, "
+          "height INTEGER DEFAULT 0, last_requested INTEGER DEFAULT 0)")) {
+    return false;
+  }
+
+  if (!db.BeginTransaction())
+    return false;
+
+  sql::Statement mapping(db.GetUniqueStatement(
+      "INSERT INTO icon_mapping (page_url, icon_id) VALUES (?, ?)"));
+  sql::Statement favicon(
+      db.GetUniqueStatement("INSERT INTO favicons (id, url) VALUES (?, ?)"));
+  sql::Statement favicon_bitmap(db.GetUniqueStatement(
+      "INSERT INTO favicon_bitmaps (icon_id, image_data, width, height) "
+      "VALUES (?, ?, ?, ?)"));
+  for (int i = 0; i < icon_count; i++) {
+    mapping.BindString(0, base::StringPrintf("https://example%d.com/", i));
+    mapping.BindInt64(1, i + 1);
+    if (!mapping.Run())
+      return false;
+    mapping.Reset(true);
+
+    favicon.BindInt64(0, i + 1);
+    favicon.BindString(1, GetTestFaviconURL(i));
+    if (!favicon.Run())
+      return false;
+    favicon.Reset(true);
+
+    favicon_bitmap.BindInt64(0, i + 1);
+    favicon_bitmap.BindBlob(1, png_data.data(), png_data.size());
+    favicon_bitmap.BindInt(2, kFaviconSize);
+    favicon_bitmap.BindInt(3, kFaviconSize);
+    if (!favicon_bitmap.Run())
+      return false;
+    favicon_bitmap.Reset(true);
+  }
+
+  return db.CommitTransaction();
+}
+
+std::string GetTestFaviconURL(int index) {
+  return base::StringPrintf("https://example%d.com/favicon.png", index);
+}
@@ -0,0 +1,27 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_TEST_UTIL_H_
+#define BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_TEST_UTIL_H_
+
+#include <string>
+
+namespace base {
+class FilePath;
+}
+
+// Creates a Chrome History database at |path| holding |visit_count| visits of
+// distinct urls, https://example<i>.com/. Returns false on failure.
+bool CreateChromeHistoryDatabase(const base::FilePath& path, int visit_count);
+
+// Creates a Chrome Favicons database at |path| holding |icon_count| decodable
+// PNG favicons, https://example<i>.com/favicon.png, each mapped to one page.
+// Returns false on failure.
+bool CreateChromeFaviconsDatabase(const base::FilePath& path, int icon_count);
+
+// The favicon url CreateChromeFaviconsDatabase uses for icon |index|.
+std::string GetTestFaviconURL(int index);
+
+#endif  // BRAVE_UTILITY_IMPORTER_CHROME_IMPORTER_TEST_UTIL_H_
@@ -6,13 +6,17 @@
 #include "brave/utility/importer/chrome_importer.h"
 
 #include <string>
+#include <vector>
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/test/task_environment.h"
 #include "brave/common/brave_paths.h"
+#include "brave/utility/importer/chrome_importer_test_util.h"
 #include "chrome/common/chrome_paths.h"
 #include "chrome/common/importer/imported_bookmark_entry.h"
 #include "chrome/common/importer/importer_data_types.h"
@@ -62,6 +66,23 @@ class ChromeImporterTest : public ::testing::Test {
     bridge_ = new MockImporterBridge;
   }
 
+  // Replaces the History database of the test profile with one holding
+  // |visit_count| visits of distinct urls.
+  void CreateLargeHistory(int visit_count) {
+    const base::FilePath history_path = profile_dir_.AppendASCII("History");
+    ASSERT_TRUE(base::DeleteFile(history_path));
+    ASSERT_TRUE(CreateChromeHistoryDatabase(history_path, visit_count));
+  }
+
+  // Replaces the Favicons database of the test profile with one holding
+  // |icon_count| favicons.
+  void CreateLargeFavicons(int icon_count) {
+    const base::FilePath favicons_path = profile_dir_.AppendASCII("Favicons");
+    ASSERT_TRUE(base::DeleteFile(favicons_path));
+    ASSERT_TRUE(CreateChromeFaviconsDatabase(favicons_path, icon_count));
+  }
+
+  base::test::TaskEnvironment task_environment_;
   base::ScopedTempDir temp_dir_;
   base::FilePath profile_dir_;
   importer::SourceProfile profile_;
@@ -87,6 +108,33 @@ TEST_F(ChromeImporterTest, ImportHistory) {
   EXPECT_EQ("https://www.nytimes.com/", history[2].url.spec());
 }
 
+TEST_F(ChromeImporterTest, ImportLargeHistoryInBatches) {
+  const int kVisitCount = ChromeImporter::kHistoryBatchSize * 2 + 500;
+  CreateLargeHistory(kVisitCount);
+
+  std::vector<size_t> batch_sizes;
+  std::vector<ImporterURLRow> history;
+
+  EXPECT_CALL(*bridge_, NotifyStarted());
+  EXPECT_CALL(*bridge_, NotifyItemStarted(importer::HISTORY));
+  EXPECT_CALL(*bridge_, SetHistoryItems(_, _))
+      .Times(3)
+      .WillRepeatedly([&](const std::vector<ImporterURLRow>& rows,
+                          importer::VisitSource visit_source) {
+        batch_sizes.push_back(rows.size());
+        history.insert(history.end(), rows.begin(), rows.end());
+      });
+  EXPECT_CALL(*bridge_, NotifyItemEnded(importer::HISTORY));
+  EXPECT_CALL(*bridge_, NotifyEnded());
+
+  importer_->StartImport(profile_, importer::HISTORY, bridge_.get());
+
+  EXPECT_EQ((std::vector<size_t>{ChromeImporter::kHistoryBatchSize,
+                                 ChromeImporter::kHistoryBatchSize, 500u}),
+            batch_sizes);
+  EXPECT_EQ(static_cast<size_t>(kVisitCount), history.size());
+}
+
 TEST_F(ChromeImporterTest, ImportBookmarks) {
   std::vector<ImportedBookmarkEntry> bookmarks;
 
@@ -137,6 +185,42 @@ TEST_F(ChromeImporterTest, ImportFavicons) {
             favicons[3].favicon_url.spec());
 }
 
+TEST_F(ChromeImporterTest, ImportLargeFaviconsInBatches) {
+  const int kIconCount = ChromeImporter::kFaviconBatchSize * 2 + 50;
+  CreateLargeFavicons(kIconCount);
+
+  std::vector<size_t> batch_sizes;
+  favicon_base::FaviconUsageDataList favicons;
+
+  EXPECT_CALL(*bridge_, NotifyStarted());
+  EXPECT_CALL(*bridge_, NotifyItemStarted(importer::FAVORITES));
+  EXPECT_CALL(*bridge_, SetFavicons(_))
+      .Times(3)
+      .WillRepeatedly(
+          [&](const favicon_base::FaviconUsageDataList& batch) {
+            batch_sizes.push_back(batch.size());
+            favicons.insert(favicons.end(), batch.begin(), batch.end());
+          });
+  EXPECT_CALL(*bridge_, NotifyItemEnded(importer::FAVORITES));
+  EXPECT_CALL(*bridge_, NotifyEnded());
+
+  importer_->StartImport(profile_, importer::FAVORITES, bridge_.get());
+
+  EXPECT_EQ((std::vector<size_t>{ChromeImporter::kFaviconBatchSize,
+                                 ChromeImporter::kFaviconBatchSize, 50u}),
+            batch_sizes);
+
+  // Every favicon is reencoded and they keep their order across batches
+  ASSERT_EQ(static_cast<size_t>(kIconCount), favicons.size());
+  for (int i = 0; i < kIconCount; i++) {
+    EXPECT_EQ(GetTestFaviconURL(i), favicons[i].favicon_url.spec());
+    EXPECT_FALSE(favicons[i].png_data.empty());
+    ASSERT_EQ(1u, favicons[i].urls.size());
+    EXPECT_EQ(base::StringPrintf("https://example%d.com/", i),
+              favicons[i].urls.begin()->spec());
+  }
+}
+
 // The mock keychain only works on macOS, so only run this test on macOS (for
 // now)
 #if defined(OS_MAC)